@@ -0,0 +1,99 @@
+/*
+Benchmark.h
+
+Every measurement is printed for reading and also kept with Record(), so that main can write them all as JSON
+(jlBenchmarks --json results.json) to compare runs across commits.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace jl
+{
+    // Makes the compiler assume value is read and modified here, so work on it can not be hoisted out of a loop or removed
+    template<typename T>
+    inline void DoNotOptimize(T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : "+m"(value) : : "memory");
+#else
+        static volatile const void* escape;
+        escape = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    // Repeats f until at least minSeconds have passed and returns the average seconds per call.
+    // Calls are timed in growing batches so that the clock is read rarely even for nanosecond operations.
+    template<typename F>
+    double TimeIt(F&& f, double minSeconds = 0.25)
+    {
+        using Clock = std::chrono::steady_clock;
+        size_t iterations = 0;
+        size_t batch = 1;
+        const auto start = Clock::now();
+        double elapsed = 0;
+        do
+        {
+            for (size_t i = 0; i < batch; ++i) f();
+            iterations += batch;
+            batch *= 2;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < minSeconds);
+        return elapsed / iterations;
+    }
+
+    struct BenchmarkResult
+    {
+        std::string Name;
+        double Seconds;
+        // processed by one operation, 0 when it does not apply
+        double Bytes;
+        double Items;
+    };
+
+    inline std::vector<BenchmarkResult>& BenchmarkResults()
+    {
+        static std::vector<BenchmarkResult> results;
+        return results;
+    }
+
+    // Joins the parts with '/', e.g. BenchmarkName("gemm", "naive", "float", 64) is "gemm/naive/float/64"
+    template<typename... Parts>
+    std::string BenchmarkName(const Parts&... parts)
+    {
+        std::ostringstream name;
+        const char* separator = "";
+        ((name << separator << parts, separator = "/"), ...);
+        return name.str();
+    }
+
+    // Keeps the seconds per operation of a benchmark for the JSON report and returns them unchanged
+    inline double Record(const std::string& name, double seconds, double bytes = 0, double items = 0)
+    {
+        BenchmarkResults().push_back({ name, seconds, bytes, items });
+        return seconds;
+    }
+
+    inline void WriteBenchmarkJson(std::ostream& os, const std::string& simdLevel)
+    {
+        os << "{\n  \"context\": { \"simd_level\": \"" << simdLevel << "\" },\n  \"benchmarks\": [";
+        const char* separator = "\n";
+        for (const auto& r : BenchmarkResults())
+        {
+            os << separator << "    { \"name\": \"" << r.Name << "\", \"ns_per_op\": " << r.Seconds * 1e9;
+            if (r.Bytes > 0) os << ", \"bytes_per_second\": " << r.Bytes / r.Seconds;
+            if (r.Items > 0) os << ", \"items_per_second\": " << r.Items / r.Seconds;
+            os << " }";
+            separator = ",\n";
+        }
+        os << "\n  ]\n}\n";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,424 @@
+/*
+MatrixBenchmark.cpp
+*/
+
+#include "JL/matrix/Matrix.h"
+#include "JL/matrix/DynamicMatrix.h"
+#include "JL/matrix/LinearTransformation.h"
+#include "JL/matrix/MatrixPack.h"
+#include "JL/matrix/RandomMatrix.h"
+
+#include "JL/benchmarks/Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace jl;
+
+namespace
+{
+    template<typename T>
+    void BenchmarkGemm(const char* typeName, size_t S)
+    {
+        auto reng = GetRandomEngine();
+        uniform_dist<T> rng(T(-1), T(1));
+
+        std::vector<T> a(S*S), b(S*S), c(S*S);
+        for (auto& v : a) v = rng(reng);
+        for (auto& v : b) v = rng(reng);
+
+        const double flops = 2.0 * S * S * S;
+        const double naive = Record(BenchmarkName("gemm", "naive", typeName, S),
+            TimeIt([&] { detail::GemmNaive(S, S, S, a.data(), S, b.data(), S, c.data(), S); }), 0, flops);
+        const double blocked = Record(BenchmarkName("gemm", "blocked", typeName, S),
+            TimeIt([&] { detail::GemmBlocked(S, S, S, a.data(), S, b.data(), S, c.data(), S); }), 0, flops);
+
+        std::cout << "  " << typeName << " " << S << "x" << S
+            << "  naive: " << flops / naive * 1e-9 << " GFLOP/s"
+            << "  blocked: " << flops / blocked * 1e-9 << " GFLOP/s"
+            << "  speedup: " << naive / blocked << "x\n";
+    }
+
+    template<typename T, size_t S>
+    void BenchmarkMatrixOperator(const char* typeName)
+    {
+        auto reng = GetRandomEngine();
+
+        // heap allocated, a few hundred rows of std::array do not fit comfortably on the stack
+        auto a = std::make_unique<Matrix<T,S,S>>(RandomMatrix<T,S,S>(reng, T(-1), T(1)));
+        auto b = std::make_unique<Matrix<T,S,S>>(RandomMatrix<T,S,S>(reng, T(-1), T(1)));
+        auto c = std::make_unique<Matrix<T,S,S>>();
+
+        const double flops = 2.0 * S * S * S;
+        const double t = Record(BenchmarkName("matrix_multiply", typeName, S), TimeIt([&] { *c = *a * *b; }), 0, flops);
+
+        std::cout << "  operator* Matrix<" << typeName << "," << S << "," << S << ">: " << flops / t * 1e-9 << " GFLOP/s\n";
+    }
+
+    // Composition of many small matrices, the loop operator* ran before GemmSmall vs operator*
+    template<typename T, size_t S>
+    void BenchmarkSmallMultiply(const char* typeName, size_t count)
+    {
+        auto reng = GetRandomEngine();
+        std::vector<Matrix<T,S,S>> a(count), b(count), c(count);
+        for (auto& m : a) m = RandomMatrix<T,S,S>(reng, T(-1), T(1));
+        for (auto& m : b) m = RandomMatrix<T,S,S>(reng, T(-1), T(1));
+
+        const double naive = Record(BenchmarkName("small_multiply", "naive", typeName, S), TimeIt([&]
+        {
+            for (size_t i = 0; i < count; ++i)
+                detail::GemmNaive(S, S, S, a[i].Elements.data(), S, b[i].Elements.data(), S, c[i].Elements.data(), S);
+            DoNotOptimize(c);
+        }), 0, double(count));
+        const double unrolled = Record(BenchmarkName("small_multiply", "operator", typeName, S), TimeIt([&]
+        {
+            for (size_t i = 0; i < count; ++i) c[i] = a[i] * b[i];
+            DoNotOptimize(c);
+        }), 0, double(count));
+
+        std::cout << "  " << count << " x Matrix<" << typeName << "," << S << "," << S << ">"
+            << "  naive: " << naive / count * 1e9 << " ns"
+            << "  operator*: " << unrolled / count * 1e9 << " ns"
+            << "  speedup: " << naive / unrolled << "x\n";
+    }
+
+    // One matrix at a time vs the batch functions of MatrixPack.h vs data that is kept in packs
+    template<typename T, size_t S>
+    void BenchmarkMatrixPack(const char* typeName, size_t count)
+    {
+        using Pack = MatrixPack<T,S>;
+        constexpr size_t L = Pack::size();
+
+        auto reng = GetRandomEngine();
+        std::vector<Matrix<T,S,S>> a(count), b(count), c(count);
+        for (auto& m : a) m = RandomMatrix<T,S,S>(reng, T(-1), T(1));
+        for (auto& m : b) m = RandomMatrix<T,S,S>(reng, T(-1), T(1));
+        std::vector<Pack> pa, pb, pc(count / L);
+        for (size_t i = 0; i + L <= count; i += L)
+        {
+            pa.emplace_back(a.data() + i);
+            pb.emplace_back(b.data() + i);
+        }
+        const size_t packed = pa.size() * L;
+        std::vector<T> d(count);
+
+        auto row = [&](const char* op, double single, double batch, double packs)
+        {
+            std::cout << "  " << op << " " << count << " x Matrix<" << typeName << "," << S << "," << S << ">"
+                << "  one at a time: " << single / count * 1e9 << " ns"
+                << "  batch: " << batch / count * 1e9 << " ns"
+                << "  packs: " << packs / packed * 1e9 << " ns"
+                << "  speedup: " << single / batch << "x (batch) " << single / packs * packed / count << "x (packs)\n";
+        };
+
+        row("multiply",
+            Record(BenchmarkName("matrix_pack", "multiply", "single", typeName, S), TimeIt([&]
+                { for (size_t i = 0; i < count; ++i) c[i] = a[i] * b[i]; DoNotOptimize(c); }), 0, double(count)),
+            Record(BenchmarkName("matrix_pack", "multiply", "batch", typeName, S), TimeIt([&]
+                { Multiply(a.data(), b.data(), c.data(), count); DoNotOptimize(c); }), 0, double(count)),
+            Record(BenchmarkName("matrix_pack", "multiply", "packs", typeName, S), TimeIt([&]
+                { for (size_t i = 0; i < pa.size(); ++i) pc[i] = pa[i] * pb[i]; DoNotOptimize(pc); }), 0, double(packed)));
+
+        row("determinant",
+            Record(BenchmarkName("matrix_pack", "determinant", "single", typeName, S), TimeIt([&]
+                { for (size_t i = 0; i < count; ++i) d[i] = Determinant(a[i]); DoNotOptimize(d); }), 0, double(count)),
+            Record(BenchmarkName("matrix_pack", "determinant", "batch", typeName, S), TimeIt([&]
+                { Determinant(a.data(), d.data(), count); DoNotOptimize(d); }), 0, double(count)),
+            Record(BenchmarkName("matrix_pack", "determinant", "packs", typeName, S), TimeIt([&]
+            {
+                for (size_t i = 0; i < pa.size(); ++i)
+                {
+                    const auto p = Determinant(pa[i]);
+                    std::copy(p.begin(), p.end(), d.begin() + i * L);
+                }
+                DoNotOptimize(d);
+            }), 0, double(packed)));
+    }
+
+    template<typename T, size_t S>
+    void BenchmarkDeterminant(const char* typeName)
+    {
+        auto reng = GetRandomEngine();
+        auto a = RandomMatrix<T,S,S>(reng, T(-1), T(1));
+
+        T d = 0;
+        const double cofactor = Record(BenchmarkName("determinant", "cofactor", typeName, S),
+            TimeIt([&] { DoNotOptimize(a); d = detail::DeterminantCofactor(a); DoNotOptimize(d); }));
+        const double fast = Record(BenchmarkName("determinant", "fast", typeName, S),
+            TimeIt([&] { DoNotOptimize(a); d = Determinant(a); DoNotOptimize(d); }));
+
+        std::cout << "  Matrix<" << typeName << "," << S << "," << S << ">"
+            << "  cofactor: " << cofactor * 1e9 << " ns"
+            << "  Determinant: " << fast * 1e9 << " ns"
+            << "  speedup: " << cofactor / fast << "x\n";
+    }
+
+    template<typename T, size_t S>
+    void BenchmarkInverse(const char* typeName, size_t count)
+    {
+        auto reng = GetRandomEngine();
+
+        std::vector<Matrix<T,S,S>> matrices(count), work(count);
+        for (auto& m : matrices)
+        {
+            do m = RandomMatrix<T,S,S>(reng, T(-1), T(1));
+            while (std::abs(Determinant(m)) < T(1e-2));
+        }
+
+        const double single = Record(BenchmarkName("inverse", "single", typeName, S),
+            TimeIt([&] { work = matrices; for (auto& m : work) InverseMatrix(m); DoNotOptimize(work); }), 0, double(count));
+        const double batched = Record(BenchmarkName("inverse", "batched", typeName, S),
+            TimeIt([&] { work = matrices; InverseMatrix(work.data(), work.size()); DoNotOptimize(work); }), 0, double(count));
+
+        std::cout << "  " << count << " x Matrix<" << typeName << "," << S << "," << S << ">"
+            << "  one at a time: " << single / count * 1e9 << " ns"
+            << "  batched: " << batched / count * 1e9 << " ns"
+            << "  speedup: " << single / batched << "x\n";
+    }
+
+    template<typename T, size_t S>
+    void BenchmarkExpression(const char* typeName)
+    {
+        auto reng = GetRandomEngine();
+        auto a = std::make_unique<Matrix<T,S,S>>(RandomMatrix<T,S,S>(reng, T(-1), T(1)));
+        auto b = std::make_unique<Matrix<T,S,S>>(RandomMatrix<T,S,S>(reng, T(-1), T(1)));
+        auto c = std::make_unique<Matrix<T,S,S>>(RandomMatrix<T,S,S>(reng, T(-1), T(1)));
+        auto r = std::make_unique<Matrix<T,S,S>>();
+        const T s = T(0.5);
+
+        const double bytes = 4.0 * S * S * sizeof(T);
+        const double eager = Record(BenchmarkName("expression", "eager", typeName, S),
+            TimeIt([&] { *r = *a + *b - *c * s; DoNotOptimize(*r); }), bytes);
+        const double lazy = Record(BenchmarkName("expression", "lazy", typeName, S),
+            TimeIt([&] { Assign(*r, Lazy(*a) + *b - Lazy(*c) * s); DoNotOptimize(*r); }), bytes);
+
+        std::cout << "  a + b - c * s, Matrix<" << typeName << "," << S << "," << S << ">"
+            << "  eager: " << eager * 1e9 << " ns"
+            << "  lazy: " << lazy * 1e9 << " ns"
+            << "  speedup: " << eager / lazy << "x\n";
+    }
+
+    // ParallelMultiply on 1, 2, 4, ... threads up to every hardware thread (at least 4), speedup against 1 thread
+    template<typename F>
+    void BenchmarkParallelScaling(const char* name, const char* typeName, size_t S, F&& multiply)
+    {
+        const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<size_t> threadCounts;
+        for (size_t t = 1; t < std::max<size_t>(hardware, 4); t *= 2) threadCounts.push_back(t);
+        threadCounts.push_back(std::max<size_t>(hardware, 4));
+
+        const double flops = 2.0 * S * S * S;
+        std::cout << "  " << name << "<" << typeName << "> " << S << "x" << S << "\n";
+        double single = 0;
+        for (size_t threads : threadCounts)
+        {
+            const double t = Record(BenchmarkName("parallel_multiply", name, typeName, threads, S), TimeIt([&] { multiply(threads); }), 0, flops);
+            if (threads == 1) single = t;
+            std::cout << "    " << threads << " threads: " << flops / t * 1e-9 << " GFLOP/s  speedup: " << single / t << "x\n";
+        }
+    }
+
+    template<typename T>
+    void BenchmarkParallelDynamic(const char* typeName, size_t S)
+    {
+        auto reng = GetRandomEngine();
+        const auto a = RandomDynamicMatrix<T>(reng, S, S, T(-1), T(1));
+        const auto b = RandomDynamicMatrix<T>(reng, S, S, T(-1), T(1));
+        DynamicMatrix<T> c;
+        BenchmarkParallelScaling("DynamicMatrix", typeName, S, [&](size_t threads) { c = ParallelMultiply(a, b, threads); DoNotOptimize(c); });
+    }
+
+    template<typename T, size_t S>
+    void BenchmarkParallelMatrix(const char* typeName)
+    {
+        auto reng = GetRandomEngine();
+        auto a = std::make_unique<Matrix<T,S,S>>(RandomMatrix<T,S,S>(reng, T(-1), T(1)));
+        auto b = std::make_unique<Matrix<T,S,S>>(RandomMatrix<T,S,S>(reng, T(-1), T(1)));
+        auto c = std::make_unique<Matrix<T,S,S>>();
+        BenchmarkParallelScaling("Matrix", typeName, S, [&](size_t threads) { *c = ParallelMultiply(*a, *b, threads); DoNotOptimize(*c); });
+    }
+
+    // c += a * b through a temporary vs MultiplyAdd, b with a single column is a matrix vector product
+    template<typename T>
+    void BenchmarkMultiplyAdd(const char* typeName, size_t M, size_t N, size_t P)
+    {
+        auto reng = GetRandomEngine();
+        const auto a = RandomDynamicMatrix<T>(reng, M, N, T(-1), T(1));
+        const auto b = RandomDynamicMatrix<T>(reng, N, P, T(-1), T(1));
+        auto c = RandomDynamicMatrix<T>(reng, M, P, T(-1), T(1));
+
+        const double flops = 2.0 * M * N * P;
+        const double temporary = Record(BenchmarkName("multiply_add", "temporary", typeName, M, N, P),
+            TimeIt([&] { c += a * b; DoNotOptimize(c); }), 0, flops);
+        const double fused = Record(BenchmarkName("multiply_add", "in_place", typeName, M, N, P),
+            TimeIt([&] { MultiplyAdd(c, a, b); DoNotOptimize(c); }), 0, flops);
+
+        std::cout << "  " << typeName << " " << M << "x" << N << " * " << N << "x" << P
+            << "  c += a * b: " << flops / temporary * 1e-9 << " GFLOP/s"
+            << "  MultiplyAdd: " << flops / fused * 1e-9 << " GFLOP/s"
+            << "  speedup: " << temporary / fused << "x\n";
+    }
+
+    // Element by element transpose vs the blocked Transpose and TransposeInPlace
+    template<typename T>
+    void BenchmarkTranspose(const char* typeName, size_t S)
+    {
+        auto reng = GetRandomEngine();
+        auto a = RandomDynamicMatrix<T>(reng, S, S, T(-1), T(1));
+        DynamicMatrix<T> t(S, S);
+
+        const double bytes = 2.0 * S * S * sizeof(T);
+        const double naive = Record(BenchmarkName("transpose", "naive", typeName, S), TimeIt([&]
+        {
+            for (size_t m = 0; m < S; ++m)
+                for (size_t n = 0; n < S; ++n)
+                    t(n, m) = a(m, n);
+            DoNotOptimize(t);
+        }), bytes, 0);
+        const double blocked = Record(BenchmarkName("transpose", "blocked", typeName, S), TimeIt([&] { t = Transpose(a); DoNotOptimize(t); }), bytes, 0);
+        const double inPlace = Record(BenchmarkName("transpose", "in_place", typeName, S), TimeIt([&] { TransposeInPlace(a); DoNotOptimize(a); }), bytes, 0);
+
+        std::cout << "  " << typeName << " " << S << "x" << S
+            << "  naive: " << bytes / naive * 1e-9 << " GB/s"
+            << "  blocked: " << bytes / blocked * 1e-9 << " GB/s"
+            << "  in place: " << bytes / inPlace * 1e-9 << " GB/s"
+            << "  speedup: " << naive / blocked << "x\n";
+    }
+
+    // a^T a through a materialised transpose vs the transposed view
+    template<typename T>
+    void BenchmarkTransposedProduct(const char* typeName, size_t M, size_t N)
+    {
+        auto reng = GetRandomEngine();
+        const auto a = RandomDynamicMatrix<T>(reng, M, N, T(-1), T(1));
+        DynamicMatrix<T> c;
+
+        const double flops = 2.0 * N * M * N;
+        const double copy = Record(BenchmarkName("transposed_product", "copy", typeName, M, N), TimeIt([&] { c = Transpose(a) * a; DoNotOptimize(c); }), 0, flops);
+        const double view = Record(BenchmarkName("transposed_product", "view", typeName, M, N), TimeIt([&] { c = Transposed(a) * a; DoNotOptimize(c); }), 0, flops);
+
+        std::cout << "  " << typeName << " a = " << M << "x" << N
+            << "  Transpose(a) * a: " << flops / copy * 1e-9 << " GFLOP/s"
+            << "  Transposed(a) * a: " << flops / view * 1e-9 << " GFLOP/s"
+            << "  speedup: " << copy / view << "x\n";
+    }
+
+    // A point at a time vs the batched Transform, for a D x D (N == D) or affine (N == D + 1) matrix
+    template<typename T, size_t N, size_t D>
+    void BenchmarkTransform(const char* name, size_t count)
+    {
+        auto reng = GetRandomEngine();
+        const auto a = RandomMatrix<T,N,N>(reng, T(-2), T(2));
+        std::vector<Point<T,D>> points(count), out(count);
+        for (auto& p : points) p = RandomPoint<T,D>(reng, T(-10), T(10));
+        PointCloud<T,D> cloud(points);
+
+        const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        const double bytes = double(2 * count * sizeof(Point<T,D>));
+        const double loop = Record(BenchmarkName("transform", "per_point", name, count), TimeIt([&]
+        {
+            for (size_t i = 0; i < count; ++i) out[i] = Transform(a, points[i]);
+            DoNotOptimize(out);
+        }), bytes, double(count));
+        const double batch = Record(BenchmarkName("transform", "batch", name, count), TimeIt([&]
+        {
+            Transform(a, points.data(), out.data(), count);
+            DoNotOptimize(out);
+        }), bytes, double(count));
+        const double threaded = Record(BenchmarkName("transform", "batch", name, hardware, count), TimeIt([&]
+        {
+            Transform(a, points.data(), out.data(), count, hardware);
+            DoNotOptimize(out);
+        }), bytes, double(count));
+        const double soa = Record(BenchmarkName("transform", "point_cloud", name, count), TimeIt([&]
+        {
+            Transform(a, cloud);
+            DoNotOptimize(cloud);
+        }), bytes, double(count));
+
+        std::cout << "  " << name << " x " << count
+            << "  per point: " << loop / count * 1e9 << " ns"
+            << "  batch: " << batch / count * 1e9 << " ns"
+            << "  batch " << hardware << " threads: " << threaded / count * 1e9 << " ns"
+            << "  PointCloud: " << soa / count * 1e9 << " ns"
+            << "  speedup: " << loop / batch << "x\n";
+    }
+}
+
+void BenchmarkMatrix()
+{
+    std::cout << "##### Matrix Benchmark #####\n";
+
+    std::cout << "Benchmark 1: Matrix multiplication, naive loop vs cache blocked kernel\n";
+    for (size_t S : { 32, 64, 128, 256, 512 })
+    {
+        BenchmarkGemm<float>("float", S);
+        BenchmarkGemm<double>("double", S);
+    }
+
+    std::cout << "Benchmark 2: Matrix multiplication through operator*\n";
+    BenchmarkMatrixOperator<float, 16>("float");
+    BenchmarkMatrixOperator<float, 64>("float");
+    BenchmarkMatrixOperator<double, 64>("double");
+    BenchmarkMatrixOperator<double, 128>("double");
+
+    std::cout << "Benchmark 3: Determinant, cofactor expansion vs closed form (<= 4) / LU (> 4)\n";
+    BenchmarkDeterminant<double, 3>("double");
+    BenchmarkDeterminant<double, 4>("double");
+    BenchmarkDeterminant<double, 5>("double");
+    BenchmarkDeterminant<double, 6>("double");
+    BenchmarkDeterminant<double, 8>("double");
+    BenchmarkDeterminant<double, 10>("double");
+
+    std::cout << "Benchmark 4: Matrix inverse, per matrix cost\n";
+    BenchmarkInverse<float, 3>("float", 4096);
+    BenchmarkInverse<float, 4>("float", 4096);
+    BenchmarkInverse<double, 4>("double", 4096);
+    BenchmarkInverse<double, 8>("double", 256);
+
+    std::cout << "Benchmark 5: Elementwise chain, eager operators vs one fused Lazy() loop\n";
+    BenchmarkExpression<float, 4>("float");
+    BenchmarkExpression<float, 16>("float");
+    BenchmarkExpression<float, 128>("float");
+    BenchmarkExpression<double, 512>("double");
+
+    std::cout << "Benchmark 6: Transform of 1M points, per point cost\n";
+    BenchmarkTransform<float, 3, 3>("Matrix<float,3,3> Point<float,3>", 1 << 20);
+    BenchmarkTransform<float, 4, 3>("Matrix<float,4,4> Point<float,3> (affine)", 1 << 20);
+    BenchmarkTransform<double, 4, 3>("Matrix<double,4,4> Point<double,3> (affine)", 1 << 20);
+    BenchmarkTransform<float, 4, 4>("Matrix<float,4,4> Point<float,4>", 1 << 20);
+
+    std::cout << "Benchmark 7: Small matrix multiplication, naive loop vs unrolled operator*\n";
+    BenchmarkSmallMultiply<float, 2>("float", 256);
+    BenchmarkSmallMultiply<float, 3>("float", 256);
+    BenchmarkSmallMultiply<float, 4>("float", 256);
+    BenchmarkSmallMultiply<double, 3>("double", 256);
+    BenchmarkSmallMultiply<double, 4>("double", 256);
+
+    std::cout << "Benchmark 8: Batches of small matrices, one at a time vs MatrixPack\n";
+    BenchmarkMatrixPack<float, 3>("float", 4096);
+    BenchmarkMatrixPack<float, 4>("float", 4096);
+    BenchmarkMatrixPack<double, 4>("double", 4096);
+
+    std::cout << "Benchmark 9: Multithreaded matrix multiplication, scaling with the number of threads\n";
+    BenchmarkParallelMatrix<float, 512>("float");
+    BenchmarkParallelDynamic<float>("float", 1024);
+    BenchmarkParallelDynamic<double>("double", 1024);
+
+    std::cout << "Benchmark 10: Accumulating products, c += a * b vs in place MultiplyAdd\n";
+    BenchmarkMultiplyAdd<float>("float", 64, 64, 64);
+    BenchmarkMultiplyAdd<double>("double", 256, 256, 256);
+    BenchmarkMultiplyAdd<float>("float", 2048, 64, 2048);
+    BenchmarkMultiplyAdd<double>("double", 2048, 2048, 1);
+
+    std::cout << "Benchmark 11: Transpose, element by element vs blocked, and a^T a without the transpose\n";
+    BenchmarkTranspose<float>("float", 1024);
+    BenchmarkTranspose<float>("float", 4096);
+    BenchmarkTranspose<double>("double", 2048);
+    BenchmarkTransposedProduct<float>("float", 4096, 128);
+    BenchmarkTransposedProduct<double>("double", 512, 512);
+}
@@ -0,0 +1,501 @@
+/*
+PlyBenchmark.cpp
+*/
+
+#include "JL/geometry/Point.h"
+#include "JL/geometry/Ply.h"
+#include "JL/geometry/Random.h"
+
+#include "JL/benchmarks/Benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace jl;
+
+namespace
+{
+	// The writer before it wrote the caller's buffer directly: copy into Vert3, then a tinyply write
+	template<typename T>
+	void WritePoint3WithTinyply(const std::vector<Point<T, 3>>& points, const std::string& filename, const PlyWriteOptions& options = {})
+	{
+		struct Vert3 { T x, y, z; };
+		std::vector<Vert3> vertices(points.size());
+		std::transform(points.begin(), points.end(), vertices.begin(),
+			[](Point<T, 3> p) -> Vert3 { return { p[0],p[1],p[2] }; });
+
+		std::filebuf fb_binary;
+		fb_binary.open(filename + "-binary.ply", std::ios::out | std::ios::binary);
+		std::ostream outstream_binary(&fb_binary);
+
+		PlyFile points_file;
+		points_file.add_properties_to_element("vertex", { "x", "y", "z" },
+			Type::FLOAT32, points.size(), reinterpret_cast<uint8_t*>(vertices.data()), Type::INVALID, 0);
+		points_file.get_comments().push_back("generated by tinyply 2.3");
+		points_file.write(outstream_binary, true, options);
+	}
+
+	void BenchmarkPlyWrite(size_t count)
+	{
+		using T = float;
+
+		auto reng = GetRandomEngine();
+		std::vector<Point<T, 3>> points(count);
+		for (auto& p : points) p = RandomPoint<T, 3>(reng, -10, 10);
+
+		const std::string filename = "jlBenchmarkPly";
+		const double bytes = double(count * sizeof(Point<T, 3>));
+
+		const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+		const double tinyply = Record(BenchmarkName("ply_write", "tinyply", count),
+			TimeIt([&] { WritePoint3WithTinyply(points, filename); }), bytes, double(count));
+		const double threaded = Record(BenchmarkName("ply_write", "tinyply", hardware, count),
+			TimeIt([&] { WritePoint3WithTinyply(points, filename, PlyWriteOptions{ hardware }); }), bytes, double(count));
+		const double direct = Record(BenchmarkName("ply_write", "direct", count),
+			TimeIt([&] { WritePoint3ToPlyFile(points, filename); }), bytes, double(count));
+		const double streamed = Record(BenchmarkName("ply_write", "streamed", count), TimeIt([&]
+		{
+			Point3PlyWriter<T> writer(filename);
+			const size_t chunk = 1 << 16;
+			for (size_t i = 0; i < count; i += chunk)
+				writer.Write(points.data() + i, std::min(chunk, count - i));
+		}), bytes, double(count));
+		std::remove((filename + "-binary.ply").c_str());
+
+		std::cout << "  " << count << " points"
+			<< "  tinyply: " << bytes / tinyply * 1e-9 << " GB/s"
+			<< "  tinyply " << hardware << " threads: " << bytes / threaded * 1e-9 << " GB/s"
+			<< "  WritePoint3ToPlyFile: " << bytes / direct * 1e-9 << " GB/s"
+			<< "  Point3PlyWriter: " << bytes / streamed * 1e-9 << " GB/s"
+			<< "  speedup: " << tinyply / direct << "x\n";
+	}
+
+	template<typename T>
+	std::vector<Point<T, 3>> ReadPoint3WithTinyply(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		PlyFile ply;
+		ply.parse_header(file);
+		auto vertices = ply.request_properties_from_element("vertex", { "x", "y", "z" });
+		ply.read(file);
+		std::vector<Point<T, 3>> points(vertices->count);
+		std::memcpy(points.data(), vertices->buffer.get(), vertices->buffer.size_bytes());
+		return points;
+	}
+
+	// sums every point so that the mapped pages are actually touched
+	template<typename Points>
+	auto SumPoints(const Points& points)
+	{
+		typename std::decay_t<decltype(points[0])>::value_type total = 0;
+		for (const auto& p : points) total += p[0] + p[1] + p[2];
+		return total;
+	}
+
+	void BenchmarkPlyRead(size_t count)
+	{
+		using T = float;
+
+		auto reng = GetRandomEngine();
+		std::vector<Point<T, 3>> points(count);
+		for (auto& p : points) p = RandomPoint<T, 3>(reng, -10, 10);
+
+		const std::string filename = "jlBenchmarkPly";
+		const std::string path = filename + "-binary.ply";
+		WritePoint3ToPlyFile(points, filename);
+		const double bytes = double(count * sizeof(Point<T, 3>));
+
+		const double tinyply = Record(BenchmarkName("ply_read", "tinyply", count), TimeIt([&]
+		{
+			T total = SumPoints(ReadPoint3WithTinyply<T>(path));
+			DoNotOptimize(total);
+		}), bytes, double(count));
+		const double mapped = Record(BenchmarkName("ply_read", "mapped", count), TimeIt([&]
+		{
+			T total = SumPoints(ReadPoint3FromPlyFile<T>(path));
+			DoNotOptimize(total);
+		}), bytes, double(count));
+		std::remove(path.c_str());
+
+		std::cout << "  " << count << " points"
+			<< "  tinyply: " << bytes / tinyply * 1e-9 << " GB/s"
+			<< "  ReadPoint3FromPlyFile: " << bytes / mapped * 1e-9 << " GB/s"
+			<< "  speedup: " << tinyply / mapped << "x\n";
+	}
+
+	// The bundled test assets: bytes/s is over the whole file
+	void BenchmarkPlyAsset(const char* name)
+	{
+		using T = float;
+
+		const std::string path = std::string(JL_ASSETS_DIR) + "/" + name;
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		const double bytes = double(file.tellg());
+		const double count = double(ReadPoint3FromPlyFile<T>(path).size());
+
+		const double tinyply = Record(BenchmarkName("ply_asset", "tinyply", name), TimeIt([&]
+		{
+			T total = SumPoints(ReadPoint3WithTinyply<T>(path));
+			DoNotOptimize(total);
+		}), bytes, count);
+		const double mapped = Record(BenchmarkName("ply_asset", "mapped", name), TimeIt([&]
+		{
+			T total = SumPoints(ReadPoint3FromPlyFile<T>(path));
+			DoNotOptimize(total);
+		}), bytes, count);
+		const double write = Record(BenchmarkName("ply_asset", "write", name), TimeIt([&]
+		{
+			WritePoint3ToPlyFile(ReadPoint3FromPlyFile<T>(path).Points().data(), size_t(count), "jlBenchmarkPlyAsset");
+		}), bytes, count);
+		std::remove("jlBenchmarkPlyAsset-binary.ply");
+
+		std::cout << "  " << name << " (" << count << " points)"
+			<< "  tinyply read: " << tinyply * 1e3 << " ms"
+			<< "  ReadPoint3FromPlyFile: " << mapped * 1e3 << " ms"
+			<< "  read + WritePoint3ToPlyFile: " << write * 1e3 << " ms\n";
+	}
+
+	// Writes the vertices of a bundled asset repeated up to `count`, with all their properties, as binary
+	void WriteScaledAsset(const std::string& asset, size_t count, const std::string& path)
+	{
+		std::ifstream file(asset, std::ios::binary);
+		PlyFile in;
+		in.parse_header(file);
+		std::vector<std::pair<std::vector<std::string>, Type>> groups;
+		for (const auto& element : in.get_elements())
+		{
+			if (element.name != "vertex") continue;
+			for (const auto& property : element.properties)
+			{
+				if (groups.empty() || groups.back().second != property.propertyType) groups.push_back({ {}, property.propertyType });
+				groups.back().first.push_back(property.name);
+			}
+		}
+		std::vector<std::shared_ptr<PlyData>> data;
+		for (const auto& g : groups) data.push_back(in.request_properties_from_element("vertex", g.first));
+		in.read(file);
+
+		std::vector<std::vector<uint8_t>> scaled(groups.size());
+		PlyFile out;
+		for (size_t g = 0; g < groups.size(); ++g)
+		{
+			const size_t rowBytes = data[g]->buffer.size_bytes() / data[g]->count;
+			scaled[g].resize(count * rowBytes);
+			for (size_t i = 0; i < count; ++i)
+				std::memcpy(scaled[g].data() + i * rowBytes, data[g]->buffer.get() + (i % data[g]->count) * rowBytes, rowBytes);
+			out.add_properties_to_element("vertex", groups[g].first, groups[g].second, count, scaled[g].data(), Type::INVALID, 0);
+		}
+		std::ofstream os(path, std::ios::binary);
+		out.write(os, true);
+	}
+
+	void BenchmarkPlyParallelRead(const char* name, size_t count)
+	{
+		using T = float;
+
+		const std::string path = "jlBenchmarkPlyScaled.ply";
+		WriteScaledAsset(std::string(JL_ASSETS_DIR) + "/" + name, count, path);
+		std::ifstream size(path, std::ios::binary | std::ios::ate);
+		const double bytes = double(size.tellg());
+
+		const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+		std::vector<size_t> threadCounts = { 1, 2, 4 };
+		if (hardware > 4) threadCounts.push_back(hardware);
+
+		std::cout << "  " << name << " x " << count << " vertices (" << bytes * 1e-6 << " MB)\n";
+		const double serial = Record(BenchmarkName("ply_parallel", "tinyply", name, "serial"), TimeIt([&]
+		{
+			T total = SumPoints(ReadPoint3WithTinyply<T>(path));
+			DoNotOptimize(total);
+		}), bytes, double(count));
+		std::cout << "    tinyply serial: " << bytes / serial * 1e-9 << " GB/s\n";
+
+		for (size_t threads : threadCounts)
+		{
+			const double tinyply = Record(BenchmarkName("ply_parallel", "tinyply", name, threads), TimeIt([&]
+			{
+				std::ifstream file(path, std::ios::binary);
+				PlyFile ply;
+				ply.parse_header(file);
+				auto vertices = ply.request_properties_from_element("vertex", { "x", "y", "z" });
+				ply.read(file, PlyReadOptions{ threads });
+				DoNotOptimize(vertices);
+			}), bytes, double(count));
+			const double mapped = Record(BenchmarkName("ply_parallel", "mapped", name, threads), TimeIt([&]
+			{
+				T total = SumPoints(ReadPoint3FromPlyFile<T>(path, PlyReadOptions{ threads }));
+				DoNotOptimize(total);
+			}), bytes, double(count));
+
+			std::cout << "    " << threads << " threads"
+				<< "  tinyply fixed stride: " << bytes / tinyply * 1e-9 << " GB/s (" << serial / tinyply << "x)"
+				<< "  ReadPoint3FromPlyFile: " << bytes / mapped * 1e-9 << " GB/s\n";
+		}
+		std::remove(path.c_str());
+	}
+
+	// Vertices and face lists of a bundled mesh, hint is the list length passed to tinyply (0 for none)
+	double ReadMesh(const std::string& path, const std::string& faceElement, uint32_t hint, const PlyReadOptions& options = {})
+	{
+		return TimeIt([&]
+		{
+			std::ifstream file(path, std::ios::binary);
+			PlyFile ply;
+			ply.parse_header(file);
+			auto vertices = ply.request_properties_from_element("vertex", { "x", "y", "z" });
+			auto faces = ply.request_properties_from_element(faceElement, { "vertex_indices" }, hint);
+			ply.read(file, options);
+			DoNotOptimize(vertices);
+			DoNotOptimize(faces);
+		});
+	}
+
+	void BenchmarkPlyMesh(const char* name, const std::string& faceElement, uint32_t listLength)
+	{
+		const std::string path = std::string(JL_ASSETS_DIR) + "/" + name;
+		std::ifstream size(path, std::ios::binary | std::ios::ate);
+		const double bytes = double(size.tellg());
+
+		const double noHint = Record(BenchmarkName("ply_mesh", "no_hint", name), ReadMesh(path, faceElement, 0), bytes);
+		std::cout << "  " << name << "  no hint: " << noHint * 1e3 << " ms";
+		if (listLength > 0)
+		{
+			const double hint = Record(BenchmarkName("ply_mesh", "hint", name), ReadMesh(path, faceElement, listLength), bytes);
+			std::cout << "  list_size_hint " << listLength << ": " << hint * 1e3 << " ms";
+		}
+		std::cout << "\n";
+	}
+
+	void BenchmarkPlyAscii(const char* name)
+	{
+		const std::string path = std::string(JL_ASSETS_DIR) + "/" + name;
+		std::ifstream size(path, std::ios::binary | std::ios::ate);
+		const double bytes = double(size.tellg());
+
+		PlyReadOptions fast;
+		fast.fast_ascii = true;
+		const double stream = Record(BenchmarkName("ply_ascii", "stream", name), ReadMesh(path, "face", 3), bytes);
+		const double fromChars = Record(BenchmarkName("ply_ascii", "from_chars", name), ReadMesh(path, "face", 3, fast), bytes);
+		const double points = Record(BenchmarkName("ply_ascii", "ReadPoint3FromPlyFile", name), TimeIt([&]
+		{
+			float total = SumPoints(ReadPoint3FromPlyFile<float>(path, fast));
+			DoNotOptimize(total);
+		}), bytes);
+
+		std::cout << "  " << name
+			<< "  stream: " << bytes / stream * 1e-6 << " MB/s"
+			<< "  from_chars: " << bytes / fromChars * 1e-6 << " MB/s"
+			<< "  speedup: " << stream / fromChars << "x"
+			<< "  ReadPoint3FromPlyFile fast_ascii: " << bytes / points * 1e-6 << " MB/s\n";
+	}
+
+	// Whole file at once vs chunks of 64k points, summing the points either way
+	void BenchmarkPlyChunked(const char* name, const std::string& path)
+	{
+		using T = float;
+
+		std::ifstream size(path, std::ios::binary | std::ios::ate);
+		const double bytes = double(size.tellg());
+		const double count = double(ReadPoint3FromPlyFile<T>(path).size());
+
+		const double whole = Record(BenchmarkName("ply_chunked", "whole", name), TimeIt([&]
+		{
+			T total = SumPoints(ReadPoint3FromPlyFile<T>(path));
+			DoNotOptimize(total);
+		}), bytes, count);
+		const double chunked = Record(BenchmarkName("ply_chunked", "chunked", name), TimeIt([&]
+		{
+			T total = 0;
+			ForEachPoint3Chunk<T>(path, [&](std::span<const Point<T, 3>> chunk) { total += SumPoints(chunk); });
+			DoNotOptimize(total);
+		}), bytes, count);
+
+		std::cout << "  " << name
+			<< "  ReadPoint3FromPlyFile: " << bytes / whole * 1e-9 << " GB/s"
+			<< "  ForEachPoint3Chunk: " << bytes / chunked * 1e-9 << " GB/s\n";
+	}
+
+	// The per-value loop the big-endian post-process used before, for comparison with the vector swap
+	template<typename U>
+	void SwapEachValue(uint8_t* data, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i, data += sizeof(U))
+		{
+			uint8_t bytes[sizeof(U)];
+			std::memcpy(bytes, data, sizeof(U));
+			std::reverse(bytes, bytes + sizeof(U));
+			std::memcpy(data, bytes, sizeof(U));
+		}
+	}
+
+	void BenchmarkPlySwap(size_t bytes)
+	{
+		std::vector<uint8_t> data(bytes, 1);
+		auto run = [&](size_t width, auto scalar)
+		{
+			const size_t count = bytes / width;
+			const double loop = Record(BenchmarkName("ply_swap", "scalar", width * 8), TimeIt([&] { scalar(data.data(), count); DoNotOptimize(data); }),
+				double(bytes), double(count));
+			const double vector = Record(BenchmarkName("ply_swap", "vector", width * 8), TimeIt([&] { endian_swap_values(data.data(), count, width); DoNotOptimize(data); }),
+				double(bytes), double(count));
+			std::cout << "  " << width * 8 << " bit"
+				<< "  per value: " << double(bytes) / loop * 1e-9 << " GB/s"
+				<< "  endian_swap_values: " << double(bytes) / vector * 1e-9 << " GB/s"
+				<< "  speedup: " << loop / vector << "x\n";
+		};
+		run(2, SwapEachValue<uint16_t>);
+		run(4, SwapEachValue<uint32_t>);
+		run(8, SwapEachValue<uint64_t>);
+	}
+
+	// The same points read from a little-endian and a big-endian file
+	void BenchmarkPlyBigEndian(size_t count)
+	{
+		using T = float;
+
+		auto reng = GetRandomEngine();
+		std::vector<Point<T, 3>> points(count);
+		for (auto& p : points) p = RandomPoint<T, 3>(reng, -10, 10);
+		WritePoint3ToPlyFile(points, "jlBenchmarkPlyLittle");
+		{
+			auto swapped = points;
+			endian_swap_values(reinterpret_cast<uint8_t*>(swapped.data()), 3 * count, sizeof(T));
+			std::ofstream file("jlBenchmarkPlyBig.ply", std::ios::binary);
+			file << "ply\nformat binary_big_endian 1.0\nelement vertex " << count << "\nproperty float x\nproperty float y\nproperty float z\nend_header\n";
+			file.write(reinterpret_cast<const char*>(swapped.data()), std::streamsize(count * sizeof(Point<T, 3>)));
+		}
+		const double bytes = double(count * sizeof(Point<T, 3>));
+
+		for (const auto& [order, path] : { std::pair{ "little", "jlBenchmarkPlyLittle-binary.ply" }, std::pair{ "big", "jlBenchmarkPlyBig.ply" } })
+		{
+			const double serial = Record(BenchmarkName("ply_endian", order, "tinyply_serial"), TimeIt([&]
+			{
+				T total = SumPoints(ReadPoint3WithTinyply<T>(path));
+				DoNotOptimize(total);
+			}), bytes, double(count));
+			const double fixedStride = Record(BenchmarkName("ply_endian", order, "tinyply_fixed_stride"), TimeIt([&]
+			{
+				std::ifstream file(path, std::ios::binary);
+				PlyFile ply;
+				ply.parse_header(file);
+				auto vertices = ply.request_properties_from_element("vertex", { "x", "y", "z" });
+				ply.read(file, PlyReadOptions{ 2 });
+				DoNotOptimize(vertices);
+			}), bytes, double(count));
+			const double mapped = Record(BenchmarkName("ply_endian", order, "mapped"), TimeIt([&]
+			{
+				T total = SumPoints(ReadPoint3FromPlyFile<T>(path));
+				DoNotOptimize(total);
+			}), bytes, double(count));
+
+			std::cout << "  " << order << " endian"
+				<< "  tinyply serial: " << bytes / serial * 1e-9 << " GB/s"
+				<< "  tinyply fixed stride: " << bytes / fixedStride * 1e-9 << " GB/s"
+				<< "  ReadPoint3FromPlyFile: " << bytes / mapped * 1e-9 << " GB/s\n";
+		}
+		std::remove("jlBenchmarkPlyLittle-binary.ply");
+		std::remove("jlBenchmarkPlyBig.ply");
+	}
+
+	// Stream insertion vs to_chars, MB/s of the text written
+	void BenchmarkPlyAsciiWrite(size_t count)
+	{
+		using T = float;
+
+		auto reng = GetRandomEngine();
+		std::vector<Point<T, 3>> points(count);
+		for (auto& p : points) p = RandomPoint<T, 3>(reng, -10, 10);
+
+		const std::string filename = "jlBenchmarkPlyAscii";
+		const std::string path = filename + "-ascii.ply";
+		auto fileSize = [&]
+		{
+			std::ifstream size(path, std::ios::binary | std::ios::ate);
+			return double(size.tellg());
+		};
+
+		const double stream = TimeIt([&]
+		{
+			PlyFile ply;
+			ply.add_properties_to_element("vertex", { "x", "y", "z" }, Type::FLOAT32, count, reinterpret_cast<uint8_t*>(points.data()), Type::INVALID, 0);
+			std::ofstream file(path, std::ios::binary);
+			ply.write(file, false);
+		});
+		const double streamBytes = fileSize();
+		Record(BenchmarkName("ply_ascii_write", "stream", count), stream, streamBytes, double(count));
+
+		// the shortest round trip text is longer than the 6 digits of stream insertion
+		const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+		const double toChars = TimeIt([&] { WritePoint3ToPlyFile(points, filename, false); });
+		const double threaded = TimeIt([&] { WritePoint3ToPlyFile(points, filename, false, PlyWriteOptions{ hardware }); });
+		const double bytes = fileSize();
+		Record(BenchmarkName("ply_ascii_write", "to_chars", count), toChars, bytes, double(count));
+		Record(BenchmarkName("ply_ascii_write", "to_chars", hardware, count), threaded, bytes, double(count));
+		std::remove(path.c_str());
+
+		std::cout << "  " << count << " points"
+			<< "  stream: " << streamBytes / stream * 1e-6 << " MB/s"
+			<< "  to_chars: " << bytes / toChars * 1e-6 << " MB/s"
+			<< "  to_chars " << hardware << " threads: " << bytes / threaded * 1e-6 << " MB/s"
+			<< "  speedup: " << stream / toChars << "x per point\n";
+	}
+}
+
+void BenchmarkPly()
+{
+	std::cout << "##### Ply Benchmark #####\n";
+
+	std::cout << "Benchmark 1: Binary Point3f write\n";
+	BenchmarkPlyWrite(1 << 16);
+	BenchmarkPlyWrite(1 << 22);
+
+	std::cout << "Benchmark 2: Binary Point3f read and sum\n";
+	BenchmarkPlyRead(1 << 16);
+	BenchmarkPlyRead(1 << 22);
+
+	std::cout << "Benchmark 3: Bundled assets\n";
+	BenchmarkPlyAsset("sofa.ply");
+	BenchmarkPlyAsset("bunny.ply");
+
+	std::cout << "Benchmark 4: Parallel read of the bundled assets scaled up to 4M vertices\n";
+	BenchmarkPlyParallelRead("sofa.ply", 1 << 22);
+	BenchmarkPlyParallelRead("bunny.ply", 1 << 22);
+
+	std::cout << "Benchmark 5: Mesh read, vertices and face lists\n";
+	BenchmarkPlyMesh("sofa.ply", "face", 3);
+	BenchmarkPlyMesh("sofa_ascii.ply", "face", 3);
+	BenchmarkPlyMesh("bunny.ply", "face", 3);
+	BenchmarkPlyMesh("elephant.ply", "tristrips", 0);
+
+	std::cout << "Benchmark 6: Ascii mesh read, stream extraction vs from_chars\n";
+	BenchmarkPlyAscii("sofa_ascii.ply");
+	BenchmarkPlyAscii("bunny.ply");
+
+	std::cout << "Benchmark 7: Chunked read of 4M points\n";
+	{
+		auto reng = GetRandomEngine();
+		std::vector<Point<float, 3>> points(1 << 22);
+		for (auto& p : points) p = RandomPoint<float, 3>(reng, -10, 10);
+		WritePoint3ToPlyFile(points, "jlBenchmarkPlyChunked");
+		BenchmarkPlyChunked("packed", "jlBenchmarkPlyChunked-binary.ply");
+		std::remove("jlBenchmarkPlyChunked-binary.ply");
+
+		WriteScaledAsset(std::string(JL_ASSETS_DIR) + "/sofa.ply", 1 << 22, "jlBenchmarkPlyChunked.ply");
+		BenchmarkPlyChunked("sofa.ply scaled", "jlBenchmarkPlyChunked.ply");
+		std::remove("jlBenchmarkPlyChunked.ply");
+	}
+
+	std::cout << "Benchmark 8: Big-endian byte swap and read of 4M points\n";
+	BenchmarkPlySwap(size_t(16) << 20);
+	BenchmarkPlyBigEndian(1 << 22);
+
+	std::cout << "Benchmark 9: Ascii Point3f write\n";
+	BenchmarkPlyAsciiWrite(1 << 20);
+}
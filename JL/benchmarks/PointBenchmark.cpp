@@ -0,0 +1,148 @@
+/*
+PointBenchmark.cpp
+*/
+
+#include "JL/geometry/Point.h"
+#include "JL/geometry/PointCloud.h"
+#include "JL/geometry/Random.h"
+#include "JL/utils/Simd.h"
+
+#include "JL/benchmarks/Benchmark.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace jl;
+
+namespace
+{
+    void BenchmarkPointAddition(size_t count)
+    {
+        using T = float;
+        const size_t D = 3;
+
+        auto reng = GetRandomEngine();
+        std::vector<Point<T, D>> a(count), b(count), out(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            a[i] = RandomPoint<T, D>(reng, -10, 10);
+            b[i] = RandomPoint<T, D>(reng, -10, 10);
+        }
+
+        // two streams in, one out
+        const double bytes = 3.0 * count * sizeof(Point<T, D>);
+
+        std::cout << "  " << count << " points, per point operator+: ";
+        {
+            const double t = Record(BenchmarkName("point_add", "operator", count),
+                TimeIt([&] { for (size_t i = 0; i < count; ++i) out[i] = a[i] + b[i]; }), bytes, double(count));
+            std::cout << bytes / t * 1e-9 << " GB/s\n";
+        }
+
+        const auto detected = simd::DetectSimdLevel();
+        for (int level = 0; level <= static_cast<int>(detected); ++level)
+        {
+            simd::SetSimdLevel(static_cast<simd::SimdLevel>(level));
+            const double t = Record(BenchmarkName("point_add", "bulk", simd::ToString(simd::GetSimdLevel()), count),
+                TimeIt([&] { Add(a.data(), b.data(), out.data(), count); }), bytes, double(count));
+            std::cout << "  " << count << " points, bulk Add (" << simd::ToString(simd::GetSimdLevel()) << "): " << bytes / t * 1e-9 << " GB/s\n";
+        }
+        simd::SetSimdLevel(detected);
+    }
+
+    void BenchmarkPointCloud(size_t count)
+    {
+        using T = float;
+        const size_t D = 3;
+
+        auto reng = GetRandomEngine();
+        std::vector<Point<T, D>> points(count), work(count);
+        for (auto& p : points) p = RandomPoint<T, D>(reng, -10, 10);
+        PointCloud<T, D> cloud(points), cloudWork(points);
+        const Point<T, D> offset{ 1.0f, 2.0f, 3.0f };
+        std::vector<T> out(count);
+
+        auto report = [&](const char* name, double aos, double soa)
+        {
+            Record(BenchmarkName("point_cloud", name, "aos", count), aos, 0, double(count));
+            Record(BenchmarkName("point_cloud", name, "soa", count), soa, 0, double(count));
+            std::cout << "  " << count << " points, " << name
+                << "  AoS loop: " << aos / count * 1e9 << " ns/point"
+                << "  PointCloud: " << soa / count * 1e9 << " ns/point"
+                << "  speedup: " << aos / soa << "x\n";
+        };
+
+        // the work copies are refreshed inside the timed loop so that the points do not drift
+        report("translate",
+            TimeIt([&] { work = points; for (auto& p : work) p += offset; DoNotOptimize(work); }),
+            TimeIt([&] { cloudWork = cloud; Translate(cloudWork, offset); DoNotOptimize(cloudWork); }));
+        report("dot",
+            TimeIt([&] { for (size_t i = 0; i < count; ++i) out[i] = DotProduct(points[i], offset); DoNotOptimize(out); }),
+            TimeIt([&] { DotProduct(cloud, offset, out.data()); DoNotOptimize(out); }));
+        report("magnitude",
+            TimeIt([&] { for (size_t i = 0; i < count; ++i) out[i] = Magnitude(points[i]); DoNotOptimize(out); }),
+            TimeIt([&] { Magnitude(cloud, out.data()); DoNotOptimize(out); }));
+        report("normalise",
+            TimeIt([&] { work = points; for (auto& p : work) Normalise(p); DoNotOptimize(work); }),
+            TimeIt([&] { cloudWork = cloud; Normalise(cloudWork); DoNotOptimize(cloudWork); }));
+    }
+
+    template<typename T>
+    void BenchmarkPointOperators(const char* typeName, size_t count)
+    {
+        auto reng = GetRandomEngine();
+        std::vector<Point3<T>> a(count), b(count), out(count);
+        std::vector<T> scalars(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            a[i] = RandomPoint<T, 3>(reng, -10, 10);
+            b[i] = RandomPoint<T, 3>(reng, -10, 10);
+        }
+
+        auto run = [&](const char* name, auto&& f)
+        {
+            const double t = Record(BenchmarkName("point_op", name, typeName), TimeIt(f), 0, double(count));
+            std::cout << "  Point3<" << typeName << "> " << name << ": " << t / count * 1e9 << " ns/point\n";
+        };
+
+        run("operator-", [&] { for (size_t i = 0; i < count; ++i) out[i] = a[i] - b[i]; DoNotOptimize(out); });
+        run("operator*", [&] { for (size_t i = 0; i < count; ++i) out[i] = a[i] * T(2); DoNotOptimize(out); });
+        run("DotProduct", [&] { for (size_t i = 0; i < count; ++i) scalars[i] = DotProduct(a[i], b[i]); DoNotOptimize(scalars); });
+        run("CrossProduct", [&] { for (size_t i = 0; i < count; ++i) out[i] = CrossProduct(a[i], b[i]); DoNotOptimize(out); });
+        run("Magnitude", [&] { for (size_t i = 0; i < count; ++i) scalars[i] = Magnitude(a[i]); DoNotOptimize(scalars); });
+        run("AngleBetween", [&] { for (size_t i = 0; i < count; ++i) scalars[i] = AngleBetween(a[i], b[i]); DoNotOptimize(scalars); });
+    }
+
+    template<typename T, size_t D>
+    void BenchmarkRandomPoint(const char* typeName, size_t count)
+    {
+        auto reng = GetRandomEngine();
+        std::vector<Point<T, D>> out(count);
+
+        const double t = Record(BenchmarkName("random_point", typeName, D),
+            TimeIt([&] { for (auto& p : out) p = RandomPoint<T, D>(reng, T(-10), T(10)); DoNotOptimize(out); }), 0, double(count));
+        std::cout << "  RandomPoint<" << typeName << "," << D << ">: " << t / count * 1e9 << " ns/point\n";
+    }
+}
+
+void BenchmarkPoint()
+{
+    std::cout << "##### Point Benchmark #####\n";
+
+    std::cout << "Benchmark 1: Point3f addition (cache resident and streaming)\n";
+    BenchmarkPointAddition(2048);
+    BenchmarkPointAddition(1 << 20);
+
+    std::cout << "Benchmark 2: Point3f array of structures vs PointCloud structure of arrays\n";
+    BenchmarkPointCloud(4096);
+    BenchmarkPointCloud(1 << 20);
+
+    std::cout << "Benchmark 3: Point3 operators, per point cost\n";
+    BenchmarkPointOperators<float>("float", 4096);
+    BenchmarkPointOperators<double>("double", 4096);
+
+    std::cout << "Benchmark 4: RandomPoint generation\n";
+    BenchmarkRandomPoint<float, 3>("float", 4096);
+    BenchmarkRandomPoint<double, 3>("double", 4096);
+    BenchmarkRandomPoint<int32_t, 3>("int32", 4096);
+}
@@ -0,0 +1,51 @@
+/*
+main.cpp
+
+Benchmarks are meant to be run from an optimised build (e.g. -DCMAKE_BUILD_TYPE=Release).
+
+    jlBenchmarks                        prints the results
+    jlBenchmarks --json results.json    also writes them as JSON (ns/op, bytes/s, items/s per benchmark)
+*/
+
+#include "JL/benchmarks/Benchmark.h"
+#include "JL/utils/Simd.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+void BenchmarkMatrix();
+void BenchmarkPoint();
+void BenchmarkPly();
+
+int main(int argc, char** argv)
+{
+    std::string jsonPath;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonPath = argv[++i];
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--json <file>]\n";
+            return 1;
+        }
+    }
+
+    BenchmarkMatrix();
+    BenchmarkPoint();
+    BenchmarkPly();
+
+    if (!jsonPath.empty())
+    {
+        std::ofstream json(jsonPath);
+        jl::WriteBenchmarkJson(json, jl::simd::ToString(jl::simd::DetectSimdLevel()));
+        if (json.fail())
+        {
+            std::cerr << "failed to write " << jsonPath << "\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
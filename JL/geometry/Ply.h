@@ -1,13 +1,33 @@
 /*
 Ply.h
+
+Point3 data is stored as the "x", "y", "z" properties of a binary "vertex" element, in the byte order of the
+machine. Point<T, 3> is three tightly packed T, so the points are written straight from the caller's buffer with
+a single write after the header, there is no intermediate copy and no per point call. The header is padded to a
+multiple of 16 bytes so that the vertex block of a mapped file is aligned for any T. For tools that only take
+ascii, WritePoint3ToPlyFile(..., false) writes the points as text formatted with std::to_chars, by
+options.num_threads threads for large clouds; the values read back exactly.
+
+ReadPoint3FromPlyFile() maps the file instead of reading it. When the vertex element is exactly x, y, z of type
+T in the byte order of the machine (e.g. any file written above) the points are a view of the mapped vertex
+block and nothing is copied. Other layouts (more properties, other types or byte order, ascii) are converted
+into a vector, by options.num_threads threads for large binary files. Set options.fast_ascii to parse ascii
+files with std::from_chars.
+
+Point3PlyReader pulls the vertices of a mapped file a chunk at a time for clouds larger than memory. Each chunk is
+a view of the mapped file when the layout allows it, otherwise converted into a buffer of one chunk; the pages of
+consumed chunks are released as the reader moves on.
 */
 
 #pragma once
 
 #include "Libs/tinyply/tinyply.h"
 #include "JL/geometry/Point.h"
+#include "JL/utils/MappedFile.h"
+#include "JL/utils/Parallel.h"
 
 #include <fstream>
+#include <span>
 #include <vector>
 #include <algorithm>
 
@@ -15,8 +35,146 @@ using namespace tinyply;
 
 namespace jl
 {
+	// Writes `filename + "-binary.ply"`, or `filename + "-ascii.ply"` when isBinary is false. T is float, double or int32_t.
+	template<typename T>
+	void WritePoint3ToPlyFile(const std::vector<Point<T, 3>>& points, const std::string& filename, bool isBinary = true,
+		const PlyWriteOptions& options = {});
+	template<typename T>
+	void WritePoint3ToPlyFile(const Point<T, 3>* points, size_t count, const std::string& filename, bool isBinary = true,
+		const PlyWriteOptions& options = {});
+
+	/*
+	Streams points to `filename + "-binary.ply"` one chunk at a time, for clouds that are produced piece by piece
+	or do not fit in memory. The header is written up front with a space padded vertex count, which Close() (or
+	the destructor) overwrites with the number of points written.
+	*/
+	template<typename T>
+	class Point3PlyWriter
+	{
+	public:
+		explicit Point3PlyWriter(const std::string& filename);
+		~Point3PlyWriter();
+
+		Point3PlyWriter(const Point3PlyWriter&) = delete;
+		Point3PlyWriter& operator=(const Point3PlyWriter&) = delete;
+
+		void Write(const Point<T, 3>* points, size_t count);
+		void Write(const std::vector<Point<T, 3>>& points) { Write(points.data(), points.size()); }
+
+		size_t Count() const { return NumPoints; }
+		// Patches the vertex count and closes the file, no more points can be written
+		void Close();
+
+	private:
+		std::string Filename;
+		std::ofstream File;
+		std::streampos CountPosition;
+		size_t NumPoints = 0;
+	};
+
+	// The points of a PLY file, either viewing the mapped file or owning a converted copy. Points() stays valid
+	// for the lifetime of this object, also across moves.
 	template<typename T>
-	void WritePoint3ToPlyFile(const std::vector<Point<T, 3>>& points, const std::string& filename);
+	class Point3PlyData
+	{
+	public:
+		std::span<const Point<T, 3>> Points() const { return View; }
+		size_t size() const { return View.size(); }
+		bool empty() const { return View.empty(); }
+		const Point<T, 3>& operator[](size_t i) const { return View[i]; }
+		auto begin() const { return View.begin(); }
+		auto end() const { return View.end(); }
+
+		// True when Points() views the mapped file, false when they were copied
+		bool IsMapped() const { return Mapping.is_open(); }
+
+	private:
+		template<typename U>
+		friend Point3PlyData<U> ReadPoint3FromPlyFile(const std::string& path, const PlyReadOptions& options);
+
+		std::span<const Point<T, 3>> View;
+		MappedFile Mapping;
+		std::vector<Point<T, 3>> Copy;
+	};
+
+	// Reads the "x", "y", "z" properties of the "vertex" element of any PLY file, converted to T. Unlike the
+	// writers this takes the full path of the file.
+	template<typename T>
+	Point3PlyData<T> ReadPoint3FromPlyFile(const std::string& path, const PlyReadOptions& options = {});
+
+	namespace detail
+	{
+		// Where x, y, z of the vertices are in a PLY file held in memory
+		struct PlyVertexLayout
+		{
+			std::vector<tinyply::PlyElement> Elements;
+			size_t Vertex = 0;					// index of the "vertex" element
+			size_t Axis[3] = {};				// index of the x, y, z properties in it
+			tinyply::Type AxisType[3] = {};
+			bool Binary = false;
+			bool Swap = false;					// binary in the other byte order than the machine
+			size_t HeaderSize = 0;
+
+			// Binary files only, the vertex rows start at data + VertexOffset. With a fixed Stride (no list
+			// property in a vertex row) x, y, z are at AxisOffset in every row, otherwise Stride is 0.
+			size_t VertexOffset = 0;
+			size_t Stride = 0;
+			size_t AxisOffset[3] = {};
+
+			const tinyply::PlyElement& VertexElement() const { return Elements[Vertex]; }
+			size_t Count() const { return Elements[Vertex].size; }
+		};
+
+
+		// Default Point3PlyReader chunk, 768 KB of Point3f
+		constexpr size_t PlyChunkSize = 65536;
+	}
+
+	/*
+	Reads the "x", "y", "z" properties of the "vertex" element, converted to T, at most chunkSize points per call:
+
+		Point3PlyReader<float> reader(path);
+		for (auto chunk = reader.Read(); !chunk.empty(); chunk = reader.Read())
+			...
+	*/
+	template<typename T>
+	class Point3PlyReader
+	{
+	public:
+		explicit Point3PlyReader(const std::string& path, size_t chunkSize = detail::PlyChunkSize);
+		// A whole PLY file already in memory, which must outlive the reader
+		Point3PlyReader(const uint8_t* data, size_t size, size_t chunkSize = detail::PlyChunkSize);
+
+		Point3PlyReader(const Point3PlyReader&) = delete;
+		Point3PlyReader& operator=(const Point3PlyReader&) = delete;
+
+		// The next chunk, empty once every point has been read. Valid until the next call.
+		std::span<const Point<T, 3>> Read();
+
+		// Number of points in the file and read so far
+		size_t Count() const { return NumPoints; }
+		size_t Position() const { return NumRead; }
+
+	private:
+		void Open(const uint8_t* data, size_t size, const std::string& name);
+
+		MappedFile Mapping;
+		detail::PlyVertexLayout Layout;
+		const uint8_t* Data = nullptr;
+		const uint8_t* End = nullptr;
+		const uint8_t* Row = nullptr;		// next vertex row
+		size_t Evicted = 0;					// bytes of the mapping already released
+		size_t ChunkSize;
+		size_t NumPoints = 0;
+		size_t NumRead = 0;
+		bool Points = false;				// vertex rows are x, y, z of type T and nothing else
+		bool Packed = false;				// chunks are views of the mapped vertices
+		std::vector<Point<T, 3>> Chunk;
+	};
+
+	// Calls f(std::span<const Point<T, 3>>) for every chunk of points and returns the number of points
+	template<typename T, typename F>
+	size_t ForEachPoint3Chunk(const std::string& path, F&& f, size_t chunkSize = detail::PlyChunkSize);
 }
 
-#include "detail/Ply.inl"
\ No newline at end of file
+#include "detail/Ply.inl"
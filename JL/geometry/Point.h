@@ -27,38 +27,57 @@ Axioms:
 #pragma once
 
 #include <ostream>
+#include <array>
+#include <cstdint>
+
+// Lazy(), Evaluate() and Assign() fuse chains of elementwise operators into one loop
+#include "JL/utils/Expression.h"
 
 namespace jl
 {
     template <typename T, size_t D> using Point = std::array<T, D>;
 
+    // Everything marked constexpr can be evaluated at compile time, the Simd.h kernels are only used at run time
+
     template<typename T, size_t D> std::ostream& operator<<(std::ostream& os, const Point<T,D>& v);
-    template<typename T, size_t D> Point<T,D> operator+(const Point<T,D>& lhs, const Point<T,D>& rhs);
-    template<typename T, size_t D> Point<T,D> operator-(const Point<T,D>& lhs, const Point<T,D>& rhs);
-    template<typename T, size_t D> Point<T,D>& operator-(Point<T,D>& p);
-    template<typename T, size_t D> Point<T,D> operator*(const Point<T,D>& lhs, T s);
-    template<typename T, size_t D> Point<T,D> operator*(T s, const Point<T,D>& rhs);
-    template<typename T, size_t D> Point<T,D> operator/(const Point<T,D>& lhs, T s);
-
-    template<typename T, size_t D> Point<T,D>& operator+=(Point<T,D>& lhs, const Point<T,D>& rhs);
-    template<typename T, size_t D> Point<T,D>& operator-=(Point<T,D>& lhs, const Point<T,D>& rhs);
-    template<typename T, size_t D> Point<T,D>& operator*=(Point<T,D>& lhs, T s);
-    template<typename T, size_t D> Point<T,D>& operator/=(Point<T,D>& lhs, T s);
-
-    template<typename T, size_t D> T DotProduct(const Point<T,D>& lhs, const Point<T,D>& rhs);
-    template<typename T, size_t D> T ScalarTripleProduct(const Point<T,D>& a, const Point<T,D>& b, const Point<T,D>& c);
-
-    template<typename T, size_t D> T MagnitudeSquare(const Point<T,D>& p);
+    template<typename T, size_t D> constexpr Point<T,D> operator+(const Point<T,D>& lhs, const Point<T,D>& rhs);
+    template<typename T, size_t D> constexpr Point<T,D> operator-(const Point<T,D>& lhs, const Point<T,D>& rhs);
+    template<typename T, size_t D> constexpr Point<T,D>& operator-(Point<T,D>& p);
+    template<typename T, size_t D> constexpr Point<T,D> operator*(const Point<T,D>& lhs, T s);
+    template<typename T, size_t D> constexpr Point<T,D> operator*(T s, const Point<T,D>& rhs);
+    template<typename T, size_t D> constexpr Point<T,D> operator/(const Point<T,D>& lhs, T s);
+
+    template<typename T, size_t D> constexpr Point<T,D>& operator+=(Point<T,D>& lhs, const Point<T,D>& rhs);
+    template<typename T, size_t D> constexpr Point<T,D>& operator-=(Point<T,D>& lhs, const Point<T,D>& rhs);
+    template<typename T, size_t D> constexpr Point<T,D>& operator*=(Point<T,D>& lhs, T s);
+    template<typename T, size_t D> constexpr Point<T,D>& operator/=(Point<T,D>& lhs, T s);
+
+    template<typename T, size_t D> constexpr T DotProduct(const Point<T,D>& lhs, const Point<T,D>& rhs);
+    template<typename T, size_t D> constexpr T ScalarTripleProduct(const Point<T,D>& a, const Point<T,D>& b, const Point<T,D>& c);
+
+    template<typename T, size_t D> constexpr T MagnitudeSquare(const Point<T,D>& p);
     template<typename T, size_t D> T Magnitude(const Point<T,D>& p);
     template<typename T, size_t D> Point<T,D>& Normalise(Point<T,D>& p);
     
-    template<typename T, size_t D> Point<T,D> Repeat(T v);
-    template<typename T, size_t D> Point<T,D> Zero();
-    template<typename T, size_t D> Point<T,D> UnitPoint();
+    template<typename T, size_t D> constexpr Point<T,D> Repeat(T v);
+    template<typename T, size_t D> constexpr Point<T,D> Zero();
+    template<typename T, size_t D> constexpr Point<T,D> UnitPoint();
 
     template<typename T, size_t D> T AngleBetween(const Point<T,D>& lhs, const Point<T,D>& rhs);
 
-    template<typename T, size_t D> Point<T, D> ComponentMultiply(const Point<T, D>& lhs, const Point<T, D>& rhs);
+    template<typename T, size_t D> constexpr Point<T, D> ComponentMultiply(const Point<T, D>& lhs, const Point<T, D>& rhs);
+
+    //////////////////////////// Bulk operations
+
+    /*
+    Apply an operation to `count` consecutive points, e.g. out[i] = lhs[i] + rhs[i].
+    The points are processed as one flat array of count * D values so that float, double and int32_t
+    go through the vectorised kernels in Simd.h. `out` may alias one of the inputs.
+    */
+    template<typename T, size_t D> void Add(const Point<T,D>* lhs, const Point<T,D>* rhs, Point<T,D>* out, size_t count);
+    template<typename T, size_t D> void Subtract(const Point<T,D>* lhs, const Point<T,D>* rhs, Point<T,D>* out, size_t count);
+    template<typename T, size_t D> void Scale(const Point<T,D>* p, T s, Point<T,D>* out, size_t count);
+    template<typename T, size_t D> void ComponentMultiply(const Point<T,D>* lhs, const Point<T,D>* rhs, Point<T,D>* out, size_t count);
 
     //////////////////////////// Point2
 
@@ -67,7 +86,7 @@ namespace jl
     using Point2f = Point2<float>;
     using Point2d = Point2<double>;
 
-    template<typename T> T CrossProduct(const Point2<T>& lhs, const Point2<T>& rhs);
+    template<typename T> constexpr T CrossProduct(const Point2<T>& lhs, const Point2<T>& rhs);
 
     //////////////////////////// Point3
 
@@ -76,7 +95,7 @@ namespace jl
     using Point3f = Point3<float>;
     using Point3d = Point3<double>;
 
-    template<typename T> Point3<T> CrossProduct(const Point3<T>& lhs, const Point3<T>& rhs);
+    template<typename T> constexpr Point3<T> CrossProduct(const Point3<T>& lhs, const Point3<T>& rhs);
 
 } // namespace jl
 
@@ -0,0 +1,79 @@
+/*
+PointCloud.h
+
+Structure of arrays (SoA) container of points: one cache line aligned array per coordinate instead of
+one std::array per point.
+
+    std::vector<Point<T,3>>     x0 y0 z0 x1 y1 z1 x2 y2 z2 ...
+    PointCloud<T,3>             x0 x1 x2 ... | y0 y1 y2 ... | z0 z1 z2 ...
+
+A 3 wide point fills only part of a vector register, a coordinate array fills all of them. The bulk
+operations below go through the kernels in Simd.h one coordinate array at a time, so every lane does
+useful work whatever D is.
+
+Use the constructors and ToPoints() to convert from and to the usual array of points.
+*/
+
+#pragma once
+
+#include "JL/geometry/Point.h"
+#include "JL/utils/AlignedAllocator.h"
+
+#include <array>
+#include <vector>
+
+namespace jl
+{
+    template <typename T, size_t D>
+    struct PointCloud
+    {
+        using Storage = std::vector<T, AlignedAllocator<T>>;
+
+        // Coordinates[d][i] is coordinate d of point i
+        std::array<Storage, D> Coordinates;
+
+        PointCloud() = default;
+        // value initialised (zero) points
+        explicit PointCloud(size_t count);
+        PointCloud(const Point<T,D>* points, size_t count);
+        explicit PointCloud(const std::vector<Point<T,D>>& points);
+
+        size_t size() const { return Coordinates[0].size(); }
+        bool empty() const { return Coordinates[0].empty(); }
+        void resize(size_t count);
+        void reserve(size_t count);
+        void push_back(const Point<T,D>& p);
+
+        T* data(size_t d) { return Coordinates[d].data(); }
+        const T* data(size_t d) const { return Coordinates[d].data(); }
+
+        // Gathers / scatters a single point, prefer the bulk operations in loops
+        Point<T,D> operator[](size_t i) const;
+        void Set(size_t i, const Point<T,D>& p);
+
+        void ToPoints(Point<T,D>* out) const;
+        std::vector<Point<T,D>> ToPoints() const;
+    };
+
+    template<typename T, size_t D> bool operator==(const PointCloud<T,D>& lhs, const PointCloud<T,D>& rhs);
+    template<typename T, size_t D> bool operator!=(const PointCloud<T,D>& lhs, const PointCloud<T,D>& rhs);
+
+    //////////////////////////// Bulk operations
+
+    // p += offset for every point
+    template<typename T, size_t D> PointCloud<T,D>& Translate(PointCloud<T,D>& cloud, const Point<T,D>& offset);
+    // p *= s for every point
+    template<typename T, size_t D> PointCloud<T,D>& Scale(PointCloud<T,D>& cloud, T s);
+    // ComponentMultiply(p, s) for every point
+    template<typename T, size_t D> PointCloud<T,D>& Scale(PointCloud<T,D>& cloud, const Point<T,D>& s);
+
+    // out[i] = DotProduct(cloud[i], v), out holds cloud.size() values
+    template<typename T, size_t D> void DotProduct(const PointCloud<T,D>& cloud, const Point<T,D>& v, T* out);
+    template<typename T, size_t D> void MagnitudeSquare(const PointCloud<T,D>& cloud, T* out);
+    template<typename T, size_t D> void Magnitude(const PointCloud<T,D>& cloud, T* out);
+    // Every point must have a non-zero magnitude
+    template<typename T, size_t D> PointCloud<T,D>& Normalise(PointCloud<T,D>& cloud);
+
+}
+
+#include "detail/PointCloud.inl"
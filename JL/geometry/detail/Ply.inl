@@ -4,37 +4,560 @@ Ply.inl
 
 #pragma once
 
-#include <typeinfo>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace jl
 {
-	template<typename T> struct Vert3 { T x, y, z; };
+	namespace detail
+	{
+		template<typename T>
+		const char* PlyPropertyType()
+		{
+			static_assert(std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, int32_t>,
+				"PLY points are float, double or int32_t");
+			if constexpr (std::is_same_v<T, float>) return "float";
+			else if constexpr (std::is_same_v<T, double>) return "double";
+			else return "int";
+		}
+
+		// tinyply's threads come from the library's pool unless the caller gave an executor
+		template<typename Options>
+		Options WithSharedThreadPool(Options options)
+		{
+			if (!options.executor)
+				options.executor = [](size_t count, const std::function<void(size_t)>& task) { ThreadPool::Shared().Run(count, count, task); };
+			return options;
+		}
+
+		inline bool IsLittleEndian()
+		{
+			const uint16_t one = 1;
+			uint8_t firstByte;
+			std::memcpy(&firstByte, &one, 1);
+			return firstByte == 1;
+		}
+
+		// Wide enough for any size_t
+		constexpr size_t PlyCountWidth = 20;
+		// Header lengths are padded to a multiple of this, the largest property type
+		constexpr size_t PlyHeaderAlignment = 16;
+
+		// Writes the whole header and returns the position of the vertex count. The count is followed by spaces
+		// up to the next PlyHeaderAlignment boundary, with `padCount` to at least PlyCountWidth characters so that
+		// it can be overwritten in place later.
+		template<typename T>
+		std::streampos WritePoint3PlyHeader(std::ostream& os, size_t count, bool padCount)
+		{
+			std::string head = "ply\n";
+			head += IsLittleEndian() ? "format binary_little_endian 1.0\n" : "format binary_big_endian 1.0\n";
+			head += "comment generated by tinyply 2.3\n";
+			head += "element vertex ";
+
+			std::string tail = "\n";
+			for (const char* name : { "x", "y", "z" })
+				tail += std::string("property ") + PlyPropertyType<T>() + " " + name + "\n";
+			tail += "end_header\n";
+
+			std::string countText = std::to_string(count);
+			if (padCount) countText.resize(PlyCountWidth, ' ');
+			const size_t length = head.size() + countText.size() + tail.size();
+			countText.append((PlyHeaderAlignment - length % PlyHeaderAlignment) % PlyHeaderAlignment, ' ');
+
+			const std::streampos countPosition = os.tellp() + std::streamoff(head.size());
+			os << head << countText << tail;
+			return countPosition;
+		}
+
+		template<typename T>
+		void WritePoint3PlyData(std::ostream& os, const Point<T, 3>* points, size_t count)
+		{
+			static_assert(sizeof(Point<T, 3>) == 3 * sizeof(T), "Point<T, 3> must be tightly packed");
+			os.write(reinterpret_cast<const char*>(points), static_cast<std::streamsize>(count * sizeof(Point<T, 3>)));
+		}
+
+		template<typename T>
+		constexpr tinyply::Type PlyType()
+		{
+			if constexpr (std::is_same_v<T, int8_t>) return tinyply::Type::INT8;
+			else if constexpr (std::is_same_v<T, uint8_t>) return tinyply::Type::UINT8;
+			else if constexpr (std::is_same_v<T, int16_t>) return tinyply::Type::INT16;
+			else if constexpr (std::is_same_v<T, uint16_t>) return tinyply::Type::UINT16;
+			else if constexpr (std::is_same_v<T, int32_t>) return tinyply::Type::INT32;
+			else if constexpr (std::is_same_v<T, uint32_t>) return tinyply::Type::UINT32;
+			else if constexpr (std::is_same_v<T, float>) return tinyply::Type::FLOAT32;
+			else if constexpr (std::is_same_v<T, double>) return tinyply::Type::FLOAT64;
+			else return tinyply::Type::INVALID;
+		}
+
+		inline size_t PlyTypeSize(tinyply::Type t)
+		{
+			return static_cast<size_t>(tinyply::PropertyTable[t].stride);
+		}
+
+		// Read only istream buffer over memory. Seekable, so that tinyply's fast ascii reader can find the size of
+		// the remaining text and take it in one read
+		class PlyMemoryBuffer : public std::streambuf
+		{
+		public:
+			PlyMemoryBuffer(const uint8_t* data, size_t size)
+			{
+				char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+				setg(begin, begin, begin + size);
+			}
+
+		protected:
+			pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+			{
+				if (which & std::ios_base::out) return pos_type(off_type(-1));
+				char* base = dir == std::ios_base::beg ? eback() : dir == std::ios_base::cur ? gptr() : egptr();
+				const off_type position = (base - eback()) + off;
+				if (position < 0 || position > egptr() - eback()) return pos_type(off_type(-1));
+				setg(eback(), eback() + position, egptr());
+				return pos_type(position);
+			}
+
+			pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+			{
+				return seekoff(off_type(pos), std::ios_base::beg, which);
+			}
+		};
+
+		// A value of type S at src, which may be unaligned, byte swapped with `swap`
+		template<typename S>
+		S LoadPlyValue(const uint8_t* src, bool swap)
+		{
+			uint8_t bytes[sizeof(S)];
+			std::memcpy(bytes, src, sizeof(S));
+			if (swap) std::reverse(bytes, bytes + sizeof(S));
+			S value;
+			std::memcpy(&value, bytes, sizeof(S));
+			return value;
+		}
+
+		// out[3 * i + axis] = value i of type S at src + i * stride, byte swapped with `swap`
+		template<typename T, typename S>
+		void GatherPlyProperty(const uint8_t* src, size_t stride, size_t count, bool swap, Point<T, 3>* out, size_t axis)
+		{
+			for (size_t i = 0; i < count; ++i, src += stride)
+				out[i][axis] = static_cast<T>(LoadPlyValue<S>(src, swap));
+		}
+
+		template<typename T>
+		void GatherPlyProperty(tinyply::Type t, const uint8_t* src, size_t stride, size_t count, bool swap, Point<T, 3>* out, size_t axis)
+		{
+			switch (t)
+			{
+			case tinyply::Type::INT8: GatherPlyProperty<T, int8_t>(src, stride, count, swap, out, axis); break;
+			case tinyply::Type::UINT8: GatherPlyProperty<T, uint8_t>(src, stride, count, swap, out, axis); break;
+			case tinyply::Type::INT16: GatherPlyProperty<T, int16_t>(src, stride, count, swap, out, axis); break;
+			case tinyply::Type::UINT16: GatherPlyProperty<T, uint16_t>(src, stride, count, swap, out, axis); break;
+			case tinyply::Type::INT32: GatherPlyProperty<T, int32_t>(src, stride, count, swap, out, axis); break;
+			case tinyply::Type::UINT32: GatherPlyProperty<T, uint32_t>(src, stride, count, swap, out, axis); break;
+			case tinyply::Type::FLOAT32: GatherPlyProperty<T, float>(src, stride, count, swap, out, axis); break;
+			case tinyply::Type::FLOAT64: GatherPlyProperty<T, double>(src, stride, count, swap, out, axis); break;
+			default: throw std::runtime_error("invalid ply property type");
+			}
+		}
+
+		// Row size in bytes of a binary element, 0 if a property is a list (rows of different sizes)
+		inline size_t PlyFixedStride(const tinyply::PlyElement& element)
+		{
+			size_t stride = 0;
+			for (const auto& property : element.properties)
+			{
+				if (property.isList) return 0;
+				stride += PlyTypeSize(property.propertyType);
+			}
+			return stride;
+		}
+
+		inline size_t ReadPlyListCount(tinyply::Type t, const uint8_t* src, bool swap)
+		{
+			switch (t)
+			{
+			case tinyply::Type::INT8: return static_cast<size_t>(LoadPlyValue<int8_t>(src, swap));
+			case tinyply::Type::UINT8: return LoadPlyValue<uint8_t>(src, swap);
+			case tinyply::Type::INT16: return static_cast<size_t>(LoadPlyValue<int16_t>(src, swap));
+			case tinyply::Type::UINT16: return LoadPlyValue<uint16_t>(src, swap);
+			case tinyply::Type::INT32: return static_cast<size_t>(LoadPlyValue<int32_t>(src, swap));
+			case tinyply::Type::UINT32: return LoadPlyValue<uint32_t>(src, swap);
+			default: throw std::runtime_error("invalid ply list count type");
+			}
+		}
+
+		// Walks one binary row, storing where each property starts in `properties` when given. Returns the next row.
+		inline const uint8_t* WalkPlyBinaryRow(const tinyply::PlyElement& element, const uint8_t* row, const uint8_t* end, bool swap,
+			const uint8_t** properties = nullptr)
+		{
+			for (size_t p = 0; p < element.properties.size(); ++p)
+			{
+				const auto& property = element.properties[p];
+				size_t bytes = PlyTypeSize(property.propertyType);
+				if (property.isList)
+				{
+					const size_t countSize = PlyTypeSize(property.listType);
+					if (static_cast<size_t>(end - row) < countSize) throw std::runtime_error("truncated ply data");
+					bytes *= ReadPlyListCount(property.listType, row, swap);
+					row += countSize;
+				}
+				if (static_cast<size_t>(end - row) < bytes) throw std::runtime_error("truncated ply data");
+				if (properties) properties[p] = row;
+				row += bytes;
+			}
+			return row;
+		}
+
+		inline const uint8_t* SkipPlyBinaryRows(const tinyply::PlyElement& element, size_t rows, const uint8_t* row, const uint8_t* end, bool swap)
+		{
+			const size_t stride = PlyFixedStride(element);
+			if (stride > 0 || element.properties.empty())
+			{
+				if (static_cast<size_t>(end - row) / std::max<size_t>(stride, 1) < rows) throw std::runtime_error("truncated ply data");
+				return row + rows * stride;
+			}
+			for (size_t i = 0; i < rows; ++i) row = WalkPlyBinaryRow(element, row, end, swap);
+			return row;
+		}
+
+		// Parses the header at the start of data and locates the vertices
+		inline PlyVertexLayout ParsePlyVertexLayout(const uint8_t* data, size_t size, const std::string& name)
+		{
+			if (size < 3 || std::memcmp(data, "ply", 3) != 0) throw std::runtime_error(name + " is not a ply file");
+
+			PlyMemoryBuffer buffer(data, size);
+			std::istream stream(&buffer);
+			PlyFile ply;
+			if (!ply.parse_header(stream)) throw std::runtime_error("invalid ply header in " + name);
+
+			PlyVertexLayout layout;
+			layout.HeaderSize = static_cast<size_t>(stream.tellg());
+			layout.Elements = ply.get_elements();
+			layout.Binary = ply.is_binary_file();
+			layout.Swap = layout.Binary && ply.is_big_endian_file() == IsLittleEndian();
+
+			const auto vertex = std::find_if(layout.Elements.begin(), layout.Elements.end(),
+				[](const tinyply::PlyElement& e) { return e.name == "vertex"; });
+			if (vertex == layout.Elements.end()) throw std::runtime_error(name + " has no vertex element");
+			layout.Vertex = static_cast<size_t>(vertex - layout.Elements.begin());
+
+			const char* const axisNames[] = { "x", "y", "z" };
+			for (size_t axis = 0; axis < 3; ++axis)
+			{
+				const auto& properties = vertex->properties;
+				const auto property = std::find_if(properties.begin(), properties.end(),
+					[&](const tinyply::PlyProperty& p) { return p.name == axisNames[axis]; });
+				if (property == properties.end() || property->isList) throw std::runtime_error(name + " has no vertex x, y, z");
+				if (property->propertyType == tinyply::Type::INVALID) throw std::runtime_error(name + " has an invalid vertex property type");
+				layout.Axis[axis] = static_cast<size_t>(property - properties.begin());
+				layout.AxisType[axis] = property->propertyType;
+			}
+
+			if (layout.Binary)
+			{
+				const uint8_t* row = data + layout.HeaderSize;
+				for (size_t e = 0; e < layout.Vertex; ++e)
+					row = SkipPlyBinaryRows(layout.Elements[e], layout.Elements[e].size, row, data + size, layout.Swap);
+				layout.VertexOffset = static_cast<size_t>(row - data);
+
+				layout.Stride = PlyFixedStride(*vertex);
+				if (layout.Stride > 0)
+				{
+					if ((size - layout.VertexOffset) / layout.Stride < vertex->size) throw std::runtime_error(name + " is truncated");
+					for (size_t axis = 0; axis < 3; ++axis)
+						for (size_t p = 0; p < layout.Axis[axis]; ++p)
+							layout.AxisOffset[axis] += PlyTypeSize(vertex->properties[p].propertyType);
+				}
+			}
+			return layout;
+		}
+
+		// Binary vertex rows that hold nothing but x, y, z of type T, in this order
+		template<typename T>
+		bool IsPlyPoint3Row(const PlyVertexLayout& layout)
+		{
+			return layout.Binary && layout.Stride == 3 * sizeof(T) &&
+				layout.AxisOffset[0] == 0 && layout.AxisOffset[1] == sizeof(T) && layout.AxisOffset[2] == 2 * sizeof(T) &&
+				std::all_of(std::begin(layout.AxisType), std::end(layout.AxisType), [](tinyply::Type t) { return t == PlyType<T>(); });
+		}
+
+		// Copies count Point3 rows from src, reversing the byte order of every coordinate with vector shuffles
+		template<typename T>
+		void CopySwappedPlyPoints(const uint8_t* src, size_t count, Point<T, 3>* out)
+		{
+			std::memcpy(out, src, count * sizeof(Point<T, 3>));
+			tinyply::endian_swap_values(reinterpret_cast<uint8_t*>(out), 3 * count, sizeof(T));
+		}
+
+		// The next value of the cursor, converted from the file's type t
+		template<typename T>
+		T ReadPlyAscii(tinyply::Type t, tinyply::AsciiCursor& cursor)
+		{
+			if (t == tinyply::Type::FLOAT32) return static_cast<T>(tinyply::ply_read_ascii_fast<float>(cursor));
+			if (t == tinyply::Type::FLOAT64) return static_cast<T>(tinyply::ply_read_ascii_fast<double>(cursor));
+			return static_cast<T>(tinyply::ply_read_ascii_fast<int64_t>(cursor));
+		}
+
+		// Reads one ascii row, out receives x, y, z when given
+		template<typename T>
+		void ReadPlyAsciiRow(const tinyply::PlyElement& element, tinyply::AsciiCursor& cursor, const PlyVertexLayout* layout = nullptr,
+			Point<T, 3>* out = nullptr)
+		{
+			for (size_t p = 0; p < element.properties.size(); ++p)
+			{
+				if (element.properties[p].isList)
+				{
+					const size_t count = tinyply::ply_read_ascii_fast<size_t>(cursor);
+					for (size_t i = 0; i < count; ++i) cursor.token();
+					continue;
+				}
+				// x, y and z are converted, the other values only skipped
+				size_t axis = 0;
+				while (out && axis < 3 && layout->Axis[axis] != p) ++axis;
+				if (out && axis < 3) (*out)[axis] = ReadPlyAscii<T>(layout->AxisType[axis], cursor);
+				else cursor.token();
+			}
+		}
+	}
+
+	template<typename T>
+	void WritePoint3ToPlyFile(const std::vector<Point<T, 3>>& points, const std::string& filename, bool isBinary,
+		const PlyWriteOptions& options)
+	{
+		WritePoint3ToPlyFile(points.data(), points.size(), filename, isBinary, options);
+	}
+
+	template<typename T>
+	void WritePoint3ToPlyFile(const Point<T, 3>* points, size_t count, const std::string& filename, bool isBinary,
+		const PlyWriteOptions& options)
+	{
+		std::ofstream file(filename + (isBinary ? "-binary.ply" : "-ascii.ply"), std::ios::out | std::ios::binary);
+		if (file.fail()) throw std::runtime_error("failed to open " + filename);
+
+		if (isBinary)
+		{
+			detail::WritePoint3PlyHeader<T>(file, count, false);
+			detail::WritePoint3PlyData(file, points, count);
+		}
+		else
+		{
+			static_assert(std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, int32_t>,
+				"PLY points are float, double or int32_t");
+			static_assert(sizeof(Point<T, 3>) == 3 * sizeof(T), "Point<T, 3> must be tightly packed");
+			PlyFile ply;
+			ply.add_properties_to_element("vertex", { "x", "y", "z" }, detail::PlyType<T>(), count,
+				reinterpret_cast<const uint8_t*>(points), Type::INVALID, 0);
+			ply.get_comments().push_back("generated by tinyply 2.3");
+			PlyWriteOptions ascii = detail::WithSharedThreadPool(options);
+			ascii.fast_ascii = true;
+			ply.write(file, false, ascii);
+		}
+		if (file.fail()) throw std::runtime_error("failed to write " + filename);
+	}
 
 	template<typename T>
-	void WritePoint3ToPlyFile(const std::vector<Point<T, 3>>& points, const std::string& filename)
+	Point3PlyWriter<T>::Point3PlyWriter(const std::string& filename)
+		: Filename(filename + "-binary.ply"), File(Filename, std::ios::out | std::ios::binary)
 	{
-		std::vector<Vert3<T>> vertices(points.size());
-		std::transform(points.begin(), points.end(), vertices.begin(),
-			[](Point<T, 3> p) -> Vert3<T> { return { p[0],p[1],p[2] }; });
+		if (File.fail()) throw std::runtime_error("failed to open " + filename);
+		CountPosition = detail::WritePoint3PlyHeader<T>(File, 0, true);
+	}
 
-		std::filebuf fb_binary;
-		fb_binary.open(filename + "-binary.ply", std::ios::out | std::ios::binary);
-		std::ostream outstream_binary(&fb_binary);
-		if (outstream_binary.fail()) throw std::runtime_error("failed to open " + filename);
+	template<typename T>
+	Point3PlyWriter<T>::~Point3PlyWriter()
+	{
+		try { Close(); }
+		catch (...) {}
+	}
 
-		PlyFile points_file;
+	template<typename T>
+	void Point3PlyWriter<T>::Write(const Point<T, 3>* points, size_t count)
+	{
+		if (!File.is_open()) throw std::logic_error("write to closed " + Filename);
+		detail::WritePoint3PlyData(File, points, count);
+		if (File.fail()) throw std::runtime_error("failed to write " + Filename);
+		NumPoints += count;
+	}
 
-		Type outputType;
-		if (typeid(T) == typeid(float)) outputType = Type::FLOAT32;
-		else							outputType = Type::FLOAT64;
+	template<typename T>
+	void Point3PlyWriter<T>::Close()
+	{
+		if (!File.is_open()) return;
 
-		points_file.add_properties_to_element("vertex", { "x", "y", "z" },
-			outputType, points.size(), reinterpret_cast<uint8_t*>(vertices.data()), Type::INVALID, 0);
+		File.seekp(CountPosition);
+		File << std::to_string(NumPoints);
+		const bool failed = File.fail();
+		File.close();
+		if (failed) throw std::runtime_error("failed to write " + Filename);
+	}
 
-		points_file.get_comments().push_back("generated by tinyply 2.3");
+	template<typename T>
+	Point3PlyData<T> ReadPoint3FromPlyFile(const std::string& path, const PlyReadOptions& options)
+	{
+		static_assert(std::is_arithmetic_v<T>, "PLY points are converted to an arithmetic type");
+		static_assert(sizeof(Point<T, 3>) == 3 * sizeof(T), "Point<T, 3> must be tightly packed");
+
+		Point3PlyData<T> result;
+		MappedFile mapping(path);
+		const uint8_t* data = mapping.data();
+		const auto layout = detail::ParsePlyVertexLayout(data, mapping.size(), path);
+		const size_t count = layout.Count();
+
+		// x, y, z at the same offsets of every binary vertex row
+		if (layout.Binary && layout.Stride > 0)
+		{
+			const uint8_t* vertices = data + layout.VertexOffset;
+			const size_t stride = layout.Stride;
+
+			const bool points = detail::IsPlyPoint3Row<T>(layout);
+			if (points && !layout.Swap && reinterpret_cast<uintptr_t>(vertices) % alignof(Point<T, 3>) == 0)
+			{
+				result.View = { reinterpret_cast<const Point<T, 3>*>(vertices), count };
+				result.Mapping = std::move(mapping);
+				return result;
+			}
 
-		// Write a binary file
-		points_file.write(outstream_binary, true);
+			result.Copy.resize(count);
+			ParallelFor(count, options.num_threads, [&](size_t begin, size_t end)
+			{
+				if (points && layout.Swap)
+				{
+					// in slices that stay in cache between the copy and the swap
+					for (size_t first = begin; first < end; first += detail::PlyChunkSize)
+						detail::CopySwappedPlyPoints(vertices + first * stride, std::min(detail::PlyChunkSize, end - first), result.Copy.data() + first);
+					return;
+				}
+				for (size_t axis = 0; axis < 3; ++axis)
+					detail::GatherPlyProperty(layout.AxisType[axis], vertices + begin * stride + layout.AxisOffset[axis], stride, end - begin,
+						layout.Swap, result.Copy.data() + begin, axis);
+			});
+			result.View = result.Copy;
+			return result;
+		}
+
+		// ascii, or lists in the vertex rows: let tinyply parse the mapped file
+		detail::PlyMemoryBuffer buffer(data, mapping.size());
+		std::istream stream(&buffer);
+		PlyFile ply;
+		ply.parse_header(stream);
+		auto vertices = ply.request_properties_from_element("vertex", { "x", "y", "z" });
+		ply.read(stream, detail::WithSharedThreadPool(options));
+		const size_t valueSize = detail::PlyTypeSize(vertices->t);
+		result.Copy.resize(vertices->count);
+		for (size_t axis = 0; axis < 3; ++axis)
+			detail::GatherPlyProperty(vertices->t, vertices->buffer.get() + axis * valueSize, 3 * valueSize, vertices->count, false, result.Copy.data(), axis);
+		result.View = result.Copy;
+		return result;
+	}
+
+	template<typename T>
+	Point3PlyReader<T>::Point3PlyReader(const std::string& path, size_t chunkSize)
+		: Mapping(path), ChunkSize(chunkSize)
+	{
+		Open(Mapping.data(), Mapping.size(), path);
+	}
+
+	template<typename T>
+	Point3PlyReader<T>::Point3PlyReader(const uint8_t* data, size_t size, size_t chunkSize)
+		: ChunkSize(chunkSize)
+	{
+		Open(data, size, "ply data");
+	}
+
+	template<typename T>
+	void Point3PlyReader<T>::Open(const uint8_t* data, size_t size, const std::string& name)
+	{
+		static_assert(std::is_arithmetic_v<T>, "PLY points are converted to an arithmetic type");
+		if (ChunkSize == 0) throw std::invalid_argument("chunk size must not be 0");
+
+		Data = data;
+		End = data + size;
+		Layout = detail::ParsePlyVertexLayout(data, size, name);
+		NumPoints = Layout.Count();
+
+		if (Layout.Binary)
+		{
+			Row = data + Layout.VertexOffset;
+			Points = detail::IsPlyPoint3Row<T>(Layout);
+			Packed = Points && !Layout.Swap && reinterpret_cast<uintptr_t>(Row) % alignof(Point<T, 3>) == 0;
+		}
+		else
+		{
+			tinyply::AsciiCursor cursor{ reinterpret_cast<const char*>(data + Layout.HeaderSize), reinterpret_cast<const char*>(End) };
+			for (size_t e = 0; e < Layout.Vertex; ++e)
+				for (size_t i = 0; i < Layout.Elements[e].size; ++i) detail::ReadPlyAsciiRow<T>(Layout.Elements[e], cursor);
+			Row = reinterpret_cast<const uint8_t*>(cursor.pos);
+		}
+	}
+
+	template<typename T>
+	std::span<const Point<T, 3>> Point3PlyReader<T>::Read()
+	{
+		const size_t n = std::min(ChunkSize, NumPoints - NumRead);
+		if (n == 0) return {};
+
+		// the previous chunk is done with, its pages can go
+		if (Mapping.is_open() && Row > Data + Layout.HeaderSize)
+		{
+			Mapping.Evict(Evicted, static_cast<size_t>(Row - Data) - Evicted);
+			Evicted = static_cast<size_t>(Row - Data);
+		}
+
+		NumRead += n;
+		const auto& vertex = Layout.VertexElement();
+		if (Packed)
+		{
+			const auto* points = reinterpret_cast<const Point<T, 3>*>(Row);
+			Row += n * Layout.Stride;
+			return { points, n };
+		}
+
+		Chunk.resize(n);
+		if (Points && Layout.Swap)
+		{
+			detail::CopySwappedPlyPoints(Row, n, Chunk.data());
+			Row += n * Layout.Stride;
+		}
+		else if (Layout.Binary && Layout.Stride > 0)
+		{
+			for (size_t axis = 0; axis < 3; ++axis)
+				detail::GatherPlyProperty(Layout.AxisType[axis], Row + Layout.AxisOffset[axis], Layout.Stride, n, Layout.Swap, Chunk.data(), axis);
+			Row += n * Layout.Stride;
+		}
+		else if (Layout.Binary)
+		{
+			std::vector<const uint8_t*> properties(vertex.properties.size());
+			for (size_t i = 0; i < n; ++i)
+			{
+				Row = detail::WalkPlyBinaryRow(vertex, Row, End, Layout.Swap, properties.data());
+				for (size_t axis = 0; axis < 3; ++axis)
+					detail::GatherPlyProperty(Layout.AxisType[axis], properties[Layout.Axis[axis]], 0, 1, Layout.Swap, Chunk.data() + i, axis);
+			}
+		}
+		else
+		{
+			tinyply::AsciiCursor cursor{ reinterpret_cast<const char*>(Row), reinterpret_cast<const char*>(End) };
+			for (size_t i = 0; i < n; ++i) detail::ReadPlyAsciiRow<T>(vertex, cursor, &Layout, &Chunk[i]);
+			Row = reinterpret_cast<const uint8_t*>(cursor.pos);
+		}
+		return Chunk;
+	}
+
+	template<typename T, typename F>
+	size_t ForEachPoint3Chunk(const std::string& path, F&& f, size_t chunkSize)
+	{
+		Point3PlyReader<T> reader(path, chunkSize);
+		for (auto chunk = reader.Read(); !chunk.empty(); chunk = reader.Read()) f(chunk);
+		return reader.Position();
 	}
 
-}
\ No newline at end of file
+}
@@ -5,9 +5,11 @@ Point.inl
 #pragma once
 
 #include "JL/utils/Utils.h"
+#include "JL/utils/Simd.h"
 
 #include <cmath>
 #include <array>
+#include <type_traits>
 
 namespace jl
 {
@@ -25,27 +27,43 @@ namespace jl
     }
 
     template<typename T, size_t D>
-    Point<T,D> operator+(const Point<T,D>& lhs, const Point<T,D>& rhs)
+    constexpr Point<T,D> operator+(const Point<T,D>& lhs, const Point<T,D>& rhs)
     {
         ASSERT(lhs.size() == rhs.size());
         Point<T,D> r;
+        if constexpr (simd::UseKernels<T,D>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::Add(lhs.data(), rhs.data(), r.data(), D);
+                return r;
+            }
+        }
         for (size_t i = 0; i < lhs.size(); ++i)
             r[i] = lhs[i] + rhs[i];
         return r;
     }
 
     template<typename T, size_t D>
-    Point<T,D> operator-(const Point<T,D>& lhs, const Point<T,D>& rhs)
+    constexpr Point<T,D> operator-(const Point<T,D>& lhs, const Point<T,D>& rhs)
     {
         ASSERT(lhs.size() == rhs.size());
         Point<T,D> r;
+        if constexpr (simd::UseKernels<T,D>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::Subtract(lhs.data(), rhs.data(), r.data(), D);
+                return r;
+            }
+        }
         for (size_t i = 0; i < lhs.size(); ++i)
             r[i] = lhs[i] - rhs[i];
         return r;
     }
 
     template<typename T, size_t D>
-    Point<T,D> operator*(const Point<T,D>& lhs, T s)
+    constexpr Point<T,D> operator*(const Point<T,D>& lhs, T s)
     {
         Point<T,D> r;
         for (size_t i = 0; i < lhs.size(); ++i)
@@ -54,13 +72,13 @@ namespace jl
     }
 
     template<typename T, size_t D>
-    Point<T,D> operator*(T s, const Point<T,D>& rhs)
+    constexpr Point<T,D> operator*(T s, const Point<T,D>& rhs)
     {
         return rhs * s;
     }
 
     template<typename T, size_t D>
-    Point<T,D> operator/(const Point<T,D>& lhs, T s)
+    constexpr Point<T,D> operator/(const Point<T,D>& lhs, T s)
     {
         ASSERT(s != 0);
         Point<T,D> r;
@@ -70,7 +88,7 @@ namespace jl
     }
 
     template<typename T, size_t D>
-    Point<T,D>& operator+=(Point<T,D>& lhs, const Point<T,D>& rhs)
+    constexpr Point<T,D>& operator+=(Point<T,D>& lhs, const Point<T,D>& rhs)
     {
         ASSERT(lhs.size() == rhs.size());
         for (size_t i = 0; i < lhs.size(); ++i)
@@ -79,7 +97,7 @@ namespace jl
     }
 
     template<typename T, size_t D>
-    Point<T,D>& operator-=(Point<T,D>& lhs, const Point<T,D>& rhs)
+    constexpr Point<T,D>& operator-=(Point<T,D>& lhs, const Point<T,D>& rhs)
     {
         ASSERT(lhs.size() == rhs.size());
         for (size_t i = 0; i < lhs.size(); ++i)
@@ -88,7 +106,7 @@ namespace jl
     }
 
     template<typename T, size_t D>
-    Point<T,D>& operator*=(Point<T,D>& lhs, T s)
+    constexpr Point<T,D>& operator*=(Point<T,D>& lhs, T s)
     {
         for (size_t i = 0; i < lhs.size(); ++i)
             lhs[i] *= s;
@@ -96,7 +114,7 @@ namespace jl
     }
 
     template<typename T, size_t D>
-    Point<T,D>& operator/=(Point<T,D>& lhs, T s)
+    constexpr Point<T,D>& operator/=(Point<T,D>& lhs, T s)
     {
         ASSERT(s != 0);
         for (size_t i = 0; i < lhs.size(); ++i)
@@ -105,15 +123,20 @@ namespace jl
     }
 
     template<typename T, size_t D>
-    Point<T,D>& operator-(Point<T,D>& p)
+    constexpr Point<T,D>& operator-(Point<T,D>& p)
     {
         return p *= (T)-1;
     }
 
     template<typename T, size_t D>
-    T DotProduct(const Point<T,D>& lhs, const Point<T,D>& rhs)
+    constexpr T DotProduct(const Point<T,D>& lhs, const Point<T,D>& rhs)
     {
         ASSERT(lhs.size() == rhs.size());
+        if constexpr (simd::UseKernels<T,D>)
+        {
+            if (!std::is_constant_evaluated())
+                return simd::Dot(lhs.data(), rhs.data(), D);
+        }
         T sum = 0;
         for (size_t i = 0; i < lhs.size(); ++i)
             sum += lhs[i] * rhs[i];
@@ -121,13 +144,13 @@ namespace jl
     }
 
     template<typename T>
-    T CrossProduct(const Point<T, 2>& lhs, const Point<T, 2>& rhs)
+    constexpr T CrossProduct(const Point<T, 2>& lhs, const Point<T, 2>& rhs)
     {
         return (lhs[0] * rhs[1]) - (lhs[1] * rhs[0]);
     }
 
     template<typename T>
-    Point<T, 3> CrossProduct(const Point<T, 3>& lhs, const Point<T, 3>& rhs)
+    constexpr Point<T, 3> CrossProduct(const Point<T, 3>& lhs, const Point<T, 3>& rhs)
     {
         return Point<T, 3>{
             (lhs[1] * rhs[2]) - (lhs[2] * rhs[1]),
@@ -136,13 +159,13 @@ namespace jl
     }
 
     template<typename T, size_t D>
-    T ScalarTripleProduct(const Point<T,D>& a, const Point<T,D>& b, const Point<T,D>& c)
+    constexpr T ScalarTripleProduct(const Point<T,D>& a, const Point<T,D>& b, const Point<T,D>& c)
     {
         return DotProduct(a, CrossProduct(b, c));
     }
 
     template<typename T, size_t D>
-    T MagnitudeSquare(const Point<T,D>& p)
+    constexpr T MagnitudeSquare(const Point<T,D>& p)
     {
         return DotProduct(p, p);
     }
@@ -157,13 +180,14 @@ namespace jl
     Point<T,D>& Normalise(Point<T,D>& p)
     {
         T m = Magnitude(p);
+        ASSERT(m != 0);
         for (size_t i = 0; i < p.size(); ++i)
-            p[i] / m;
+            p[i] /= m;
         return p;
     }
 
     template<typename T, size_t D>
-    Point<T,D> Repeat(T v)
+    constexpr Point<T,D> Repeat(T v)
     {
         Point<T,D> p;
         for (size_t i = 0; i < p.size(); ++i)
@@ -172,13 +196,13 @@ namespace jl
     }
 
     template<typename T, size_t D>
-    Point<T,D> Zero()
+    constexpr Point<T,D> Zero()
     {
         return Repeat<T,D>(0);
     }
 
     template<typename T, size_t D>
-    Point<T,D> UnitPoint()
+    constexpr Point<T,D> UnitPoint()
     {
         return Repeat<T,D>(1);
     }
@@ -190,13 +214,65 @@ namespace jl
     }
 
     template<typename T, size_t D>
-    Point<T, D> ComponentMultiply(const Point<T, D>& lhs, const Point<T, D>& rhs)
+    constexpr Point<T, D> ComponentMultiply(const Point<T, D>& lhs, const Point<T, D>& rhs)
     {
         Point<T, D> p;
+        if constexpr (simd::UseKernels<T,D>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::Multiply(lhs.data(), rhs.data(), p.data(), D);
+                return p;
+            }
+        }
         for (size_t i = 0; i < D; ++i)
             p[i] = lhs[i] * rhs[i];
         return p;
     }
 
+    template<typename T, size_t D>
+    void Add(const Point<T,D>* lhs, const Point<T,D>* rhs, Point<T,D>* out, size_t count)
+    {
+        static_assert(sizeof(Point<T,D>) == D * sizeof(T), "points must be tightly packed");
+        if constexpr (simd::IsSupported<T>)
+            simd::Add(reinterpret_cast<const T*>(lhs), reinterpret_cast<const T*>(rhs), reinterpret_cast<T*>(out), count * D);
+        else
+            for (size_t i = 0; i < count; ++i)
+                out[i] = lhs[i] + rhs[i];
+    }
+
+    template<typename T, size_t D>
+    void Subtract(const Point<T,D>* lhs, const Point<T,D>* rhs, Point<T,D>* out, size_t count)
+    {
+        static_assert(sizeof(Point<T,D>) == D * sizeof(T), "points must be tightly packed");
+        if constexpr (simd::IsSupported<T>)
+            simd::Subtract(reinterpret_cast<const T*>(lhs), reinterpret_cast<const T*>(rhs), reinterpret_cast<T*>(out), count * D);
+        else
+            for (size_t i = 0; i < count; ++i)
+                out[i] = lhs[i] - rhs[i];
+    }
+
+    template<typename T, size_t D>
+    void Scale(const Point<T,D>* p, T s, Point<T,D>* out, size_t count)
+    {
+        static_assert(sizeof(Point<T,D>) == D * sizeof(T), "points must be tightly packed");
+        if constexpr (simd::IsSupported<T>)
+            simd::Scale(reinterpret_cast<const T*>(p), s, reinterpret_cast<T*>(out), count * D);
+        else
+            for (size_t i = 0; i < count; ++i)
+                out[i] = p[i] * s;
+    }
+
+    template<typename T, size_t D>
+    void ComponentMultiply(const Point<T,D>* lhs, const Point<T,D>* rhs, Point<T,D>* out, size_t count)
+    {
+        static_assert(sizeof(Point<T,D>) == D * sizeof(T), "points must be tightly packed");
+        if constexpr (simd::IsSupported<T>)
+            simd::Multiply(reinterpret_cast<const T*>(lhs), reinterpret_cast<const T*>(rhs), reinterpret_cast<T*>(out), count * D);
+        else
+            for (size_t i = 0; i < count; ++i)
+                out[i] = ComponentMultiply(lhs[i], rhs[i]);
+    }
+
 
 } // namespace jl
\ No newline at end of file
@@ -0,0 +1,231 @@
+/*
+PointCloud.inl
+*/
+
+#pragma once
+
+#include "JL/utils/Utils.h"
+#include "JL/utils/Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace jl
+{
+    namespace detail
+    {
+        // The Simd.h kernels for the types that have them, a plain loop for the others
+
+        template<typename T>
+        void CloudScale(const T* a, T s, T* out, size_t n)
+        {
+            if constexpr (simd::IsSupported<T>) simd::Scale(a, s, out, n);
+            else for (size_t i = 0; i < n; ++i) out[i] = a[i] * s;
+        }
+
+        template<typename T>
+        void CloudAddScalar(const T* a, T s, T* out, size_t n)
+        {
+            if constexpr (simd::IsSupported<T>) simd::AddScalar(a, s, out, n);
+            else for (size_t i = 0; i < n; ++i) out[i] = a[i] + s;
+        }
+
+        template<typename T>
+        void CloudScaleAdd(const T* a, T s, const T* b, T* out, size_t n)
+        {
+            if constexpr (simd::IsSupported<T>) simd::ScaleAdd(a, s, b, out, n);
+            else for (size_t i = 0; i < n; ++i) out[i] = a[i] * s + b[i];
+        }
+
+        template<typename T>
+        void CloudMultiply(const T* a, const T* b, T* out, size_t n)
+        {
+            if constexpr (simd::IsSupported<T>) simd::Multiply(a, b, out, n);
+            else for (size_t i = 0; i < n; ++i) out[i] = a[i] * b[i];
+        }
+
+        template<typename T>
+        void CloudMultiplyAdd(const T* a, const T* b, const T* c, T* out, size_t n)
+        {
+            if constexpr (simd::IsSupported<T>) simd::MultiplyAdd(a, b, c, out, n);
+            else for (size_t i = 0; i < n; ++i) out[i] = a[i] * b[i] + c[i];
+        }
+
+        template<typename T>
+        void CloudSqrt(const T* a, T* out, size_t n)
+        {
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) simd::Sqrt(a, out, n);
+            else for (size_t i = 0; i < n; ++i) out[i] = static_cast<T>(std::sqrt(a[i]));
+        }
+
+        template<typename T>
+        void CloudDivide(const T* a, const T* b, T* out, size_t n)
+        {
+            if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) simd::Divide(a, b, out, n);
+            else for (size_t i = 0; i < n; ++i) out[i] = a[i] / b[i];
+        }
+
+        // Squared magnitudes of points [begin, begin + n)
+        template<typename T, size_t D>
+        void CloudMagnitudeSquare(const PointCloud<T,D>& cloud, size_t begin, size_t n, T* out)
+        {
+            const T* x = cloud.data(0) + begin;
+            CloudMultiply(x, x, out, n);
+            for (size_t d = 1; d < D; ++d)
+            {
+                x = cloud.data(d) + begin;
+                CloudMultiplyAdd(x, x, out, out, n);
+            }
+        }
+
+        // Points per block of Normalise, the block of magnitudes stays in L1
+        constexpr size_t PointCloudBlock = 1024;
+    }
+
+    template<typename T, size_t D>
+    PointCloud<T,D>::PointCloud(size_t count)
+    {
+        resize(count);
+    }
+
+    template<typename T, size_t D>
+    PointCloud<T,D>::PointCloud(const Point<T,D>* points, size_t count)
+    {
+        for (auto& c : Coordinates) c.resize(count);
+        for (size_t i = 0; i < count; ++i)
+            for (size_t d = 0; d < D; ++d)
+                Coordinates[d][i] = points[i][d];
+    }
+
+    template<typename T, size_t D>
+    PointCloud<T,D>::PointCloud(const std::vector<Point<T,D>>& points)
+        : PointCloud(points.data(), points.size())
+    {}
+
+    template<typename T, size_t D>
+    void PointCloud<T,D>::resize(size_t count)
+    {
+        for (auto& c : Coordinates) c.resize(count);
+    }
+
+    template<typename T, size_t D>
+    void PointCloud<T,D>::reserve(size_t count)
+    {
+        for (auto& c : Coordinates) c.reserve(count);
+    }
+
+    template<typename T, size_t D>
+    void PointCloud<T,D>::push_back(const Point<T,D>& p)
+    {
+        for (size_t d = 0; d < D; ++d) Coordinates[d].push_back(p[d]);
+    }
+
+    template<typename T, size_t D>
+    Point<T,D> PointCloud<T,D>::operator[](size_t i) const
+    {
+        ASSERT(i < size());
+        Point<T,D> p;
+        for (size_t d = 0; d < D; ++d) p[d] = Coordinates[d][i];
+        return p;
+    }
+
+    template<typename T, size_t D>
+    void PointCloud<T,D>::Set(size_t i, const Point<T,D>& p)
+    {
+        ASSERT(i < size());
+        for (size_t d = 0; d < D; ++d) Coordinates[d][i] = p[d];
+    }
+
+    template<typename T, size_t D>
+    void PointCloud<T,D>::ToPoints(Point<T,D>* out) const
+    {
+        const size_t count = size();
+        for (size_t i = 0; i < count; ++i)
+            for (size_t d = 0; d < D; ++d)
+                out[i][d] = Coordinates[d][i];
+    }
+
+    template<typename T, size_t D>
+    std::vector<Point<T,D>> PointCloud<T,D>::ToPoints() const
+    {
+        std::vector<Point<T,D>> points(size());
+        ToPoints(points.data());
+        return points;
+    }
+
+    template<typename T, size_t D>
+    bool operator==(const PointCloud<T,D>& lhs, const PointCloud<T,D>& rhs)
+    {
+        return lhs.Coordinates == rhs.Coordinates;
+    }
+
+    template<typename T, size_t D>
+    bool operator!=(const PointCloud<T,D>& lhs, const PointCloud<T,D>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<typename T, size_t D>
+    PointCloud<T,D>& Translate(PointCloud<T,D>& cloud, const Point<T,D>& offset)
+    {
+        for (size_t d = 0; d < D; ++d)
+            detail::CloudAddScalar(cloud.data(d), offset[d], cloud.data(d), cloud.size());
+        return cloud;
+    }
+
+    template<typename T, size_t D>
+    PointCloud<T,D>& Scale(PointCloud<T,D>& cloud, T s)
+    {
+        for (size_t d = 0; d < D; ++d)
+            detail::CloudScale(cloud.data(d), s, cloud.data(d), cloud.size());
+        return cloud;
+    }
+
+    template<typename T, size_t D>
+    PointCloud<T,D>& Scale(PointCloud<T,D>& cloud, const Point<T,D>& s)
+    {
+        for (size_t d = 0; d < D; ++d)
+            detail::CloudScale(cloud.data(d), s[d], cloud.data(d), cloud.size());
+        return cloud;
+    }
+
+    template<typename T, size_t D>
+    void DotProduct(const PointCloud<T,D>& cloud, const Point<T,D>& v, T* out)
+    {
+        const size_t n = cloud.size();
+        detail::CloudScale(cloud.data(0), v[0], out, n);
+        for (size_t d = 1; d < D; ++d)
+            detail::CloudScaleAdd(cloud.data(d), v[d], out, out, n);
+    }
+
+    template<typename T, size_t D>
+    void MagnitudeSquare(const PointCloud<T,D>& cloud, T* out)
+    {
+        detail::CloudMagnitudeSquare(cloud, 0, cloud.size(), out);
+    }
+
+    template<typename T, size_t D>
+    void Magnitude(const PointCloud<T,D>& cloud, T* out)
+    {
+        MagnitudeSquare(cloud, out);
+        detail::CloudSqrt(out, out, cloud.size());
+    }
+
+    template<typename T, size_t D>
+    PointCloud<T,D>& Normalise(PointCloud<T,D>& cloud)
+    {
+        T m[detail::PointCloudBlock];
+        for (size_t begin = 0; begin < cloud.size(); begin += detail::PointCloudBlock)
+        {
+            const size_t n = std::min(detail::PointCloudBlock, cloud.size() - begin);
+            detail::CloudMagnitudeSquare(cloud, begin, n, m);
+            detail::CloudSqrt(m, m, n);
+            for (size_t i = 0; i < n; ++i) ASSERT(m[i] != 0);
+            for (size_t d = 0; d < D; ++d)
+                detail::CloudDivide(cloud.data(d) + begin, m, cloud.data(d) + begin, n);
+        }
+        return cloud;
+    }
+
+}
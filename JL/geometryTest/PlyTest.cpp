@@ -6,13 +6,50 @@ PlyTest.cpp
 #include "JL/geometry/Point.h"
 #include "JL/geometry/Ply.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <type_traits>
 #include <vector>
 
 using namespace jl;
 
+namespace
+{
+	// Reads the points back through tinyply, independently of the writer
+	template<typename T>
+	std::vector<Point<T, 3>> ReadPoint3WithTinyply(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		ALWAYS_ASSERT(file.good());
+
+		PlyFile ply;
+		ply.parse_header(file);
+		auto vertices = ply.request_properties_from_element("vertex", { "x", "y", "z" });
+		ply.read(file);
+
+		std::vector<Point<T, 3>> points(vertices->count);
+		if (!points.empty())
+			std::memcpy(points.data(), vertices->buffer.get(), vertices->buffer.size_bytes());
+		return points;
+	}
+
+	// Appends value in big-endian byte order
+	template<typename S>
+	void AppendBigEndian(std::string& out, S value)
+	{
+		char bytes[sizeof(S)];
+		std::memcpy(bytes, &value, sizeof(S));
+		if (detail::IsLittleEndian()) std::reverse(bytes, bytes + sizeof(S));
+		out.append(bytes, sizeof(S));
+	}
+}
+
 void TestPly()
 {
+	std::cout << "##### Ply Test #####\n";
+
 	using T = float;
 	const size_t D = 3;
 
@@ -25,5 +62,434 @@ void TestPly()
 		points.push_back(RandomPoint<T, D>(rn, -10, 10));
 	}
 
-	WritePoint3ToPlyFile(points, "test");
-}
\ No newline at end of file
+	{
+		std::cout << "Test 1: Write test\n";
+
+		WritePoint3ToPlyFile(points, "test");
+		ALWAYS_ASSERT(ReadPoint3WithTinyply<T>("test-binary.ply") == points);
+
+		// ascii values read back exactly
+		WritePoint3ToPlyFile(points, "test", false);
+		ALWAYS_ASSERT(ReadPoint3WithTinyply<T>("test-ascii.ply") == points);
+		std::vector<Point<double, D>> doubles(points.size());
+		for (size_t i = 0; i < points.size(); ++i) doubles[i] = Point<double, D>{ 1.0 / (double(i) + 3), -double(i) * 1e-300, 1e300 };
+		WritePoint3ToPlyFile(doubles, "test-double", false, PlyWriteOptions{ 4 });
+		ALWAYS_ASSERT(ReadPoint3WithTinyply<double>("test-double-ascii.ply") == doubles);
+	}
+
+	{
+		std::cout << "Test 2: Streaming write test\n";
+
+		{
+			Point3PlyWriter<T> writer("test-stream");
+			for (size_t i = 0; i < points.size(); i += 300)
+				writer.Write(points.data() + i, std::min<size_t>(300, points.size() - i));
+			ALWAYS_ASSERT(writer.Count() == points.size());
+		}
+		ALWAYS_ASSERT(ReadPoint3WithTinyply<T>("test-stream-binary.ply") == points);
+
+		{
+			Point3PlyWriter<double> writer("test-stream-empty");
+			writer.Close();
+		}
+		ALWAYS_ASSERT(ReadPoint3WithTinyply<double>("test-stream-empty-binary.ply").empty());
+	}
+
+	{
+		std::cout << "Test 3: Memory mapped read test\n";
+
+		// files written above are viewed in place
+		{
+			auto mapped = ReadPoint3FromPlyFile<T>("test-binary.ply");
+			ALWAYS_ASSERT(mapped.IsMapped() && mapped.size() == points.size());
+			ALWAYS_ASSERT(std::equal(mapped.begin(), mapped.end(), points.begin()));
+
+			// the view survives a move
+			const auto moved = std::move(mapped);
+			ALWAYS_ASSERT(std::equal(moved.begin(), moved.end(), points.begin()));
+		}
+		{
+			std::vector<Point<double, D>> doubles(points.size());
+			for (size_t i = 0; i < points.size(); ++i)
+				for (size_t d = 0; d < D; ++d) doubles[i][d] = points[i][d];
+			{
+				Point3PlyWriter<double> writer("test-stream-double");
+				writer.Write(doubles.data(), 1);
+				writer.Write(doubles.data() + 1, doubles.size() - 1);
+			}
+			const auto mapped = ReadPoint3FromPlyFile<double>("test-stream-double-binary.ply");
+			ALWAYS_ASSERT(mapped.IsMapped());
+			ALWAYS_ASSERT(std::equal(mapped.begin(), mapped.end(), doubles.begin()));
+
+			// other types are converted
+			const auto converted = ReadPoint3FromPlyFile<double>("test-binary.ply");
+			ALWAYS_ASSERT(!converted.IsMapped());
+			ALWAYS_ASSERT(std::equal(converted.begin(), converted.end(), doubles.begin()));
+		}
+		ALWAYS_ASSERT(ReadPoint3FromPlyFile<double>("test-stream-empty-binary.ply").empty());
+
+		// more vertex properties and a list element after the vertices
+		const std::string sofa = std::string(JL_ASSETS_DIR) + "/sofa.ply";
+		const auto strided = ReadPoint3FromPlyFile<T>(sofa);
+		ALWAYS_ASSERT(!strided.IsMapped() && strided.size() == 12103);
+		const auto sofaPoints = ReadPoint3WithTinyply<T>(sofa);
+		ALWAYS_ASSERT(std::equal(strided.begin(), strided.end(), sofaPoints.begin(), sofaPoints.end()));
+
+		// ascii goes through tinyply
+		const std::string bunny = std::string(JL_ASSETS_DIR) + "/bunny.ply";
+		const auto ascii = ReadPoint3FromPlyFile<T>(bunny);
+		ALWAYS_ASSERT(!ascii.IsMapped() && ascii.size() == 35947);
+		const auto bunnyPoints = ReadPoint3WithTinyply<T>(bunny);
+		ALWAYS_ASSERT(std::equal(ascii.begin(), ascii.end(), bunnyPoints.begin(), bunnyPoints.end()));
+	}
+
+	{
+		std::cout << "Test 4: Parallel read test\n";
+
+		const std::string sofa = std::string(JL_ASSETS_DIR) + "/sofa.ply";
+		auto readSofa = [&](size_t numThreads)
+		{
+			std::ifstream file(sofa, std::ios::binary);
+			PlyFile ply;
+			ply.parse_header(file);
+			auto xyz = ply.request_properties_from_element("vertex", { "x", "y", "z" });
+			auto color = ply.request_properties_from_element("vertex", { "red", "green", "blue" });
+			ply.read(file, PlyReadOptions{ numThreads });
+			return std::make_pair(xyz, color);
+		};
+		auto sameData = [](const std::shared_ptr<PlyData>& a, const std::shared_ptr<PlyData>& b)
+		{
+			return a->count == b->count && a->t == b->t && a->buffer.size_bytes() == b->buffer.size_bytes() &&
+				std::memcmp(a->buffer.get(), b->buffer.get(), a->buffer.size_bytes()) == 0;
+		};
+
+		const auto serial = readSofa(1);
+		for (size_t numThreads : { 0, 2, 3, 8 })
+		{
+			const auto parallel = readSofa(numThreads);
+			ALWAYS_ASSERT(sameData(serial.first, parallel.first) && sameData(serial.second, parallel.second));
+
+			const auto points = ReadPoint3FromPlyFile<double>(sofa, PlyReadOptions{ numThreads });
+			const auto expected = ReadPoint3FromPlyFile<double>(sofa);
+			ALWAYS_ASSERT(std::equal(points.begin(), points.end(), expected.begin(), expected.end()));
+		}
+	}
+
+	{
+		std::cout << "Test 5: List read test\n";
+
+		auto readFaces = [](const std::string& path, uint32_t hint)
+		{
+			std::ifstream file(path, std::ios::binary);
+			PlyFile ply;
+			ply.parse_header(file);
+			auto faces = ply.request_properties_from_element("face", { "vertex_indices" }, hint);
+			ply.read(file);
+			return std::vector<int32_t>(reinterpret_cast<const int32_t*>(faces->buffer.get()),
+				reinterpret_cast<const int32_t*>(faces->buffer.get() + faces->buffer.size_bytes()));
+		};
+
+		// more list data than one arena block
+		std::vector<int32_t> indices(3 * 200000);
+		for (size_t i = 0; i < indices.size(); ++i) indices[i] = static_cast<int32_t>(i % 1000);
+		for (bool binary : { true, false })
+		{
+			{
+				std::ofstream file("test-faces.ply", std::ios::binary);
+				PlyFile ply;
+				ply.add_properties_to_element("face", { "vertex_indices" }, Type::INT32, indices.size() / 3,
+					reinterpret_cast<uint8_t*>(indices.data()), Type::UINT8, 3);
+				ply.write(file, binary);
+			}
+			ALWAYS_ASSERT(readFaces("test-faces.ply", 0) == indices);
+			ALWAYS_ASSERT(readFaces("test-faces.ply", 3) == indices);
+		}
+
+		const std::string sofa = std::string(JL_ASSETS_DIR) + "/sofa.ply";
+		ALWAYS_ASSERT(readFaces(sofa, 0) == readFaces(sofa, 3));
+	}
+
+	{
+		std::cout << "Test 6: Fast ascii read test\n";
+
+		auto readMesh = [](const std::string& path, bool fastAscii, uint32_t hint)
+		{
+			std::ifstream file(path, std::ios::binary);
+			PlyFile ply;
+			ply.parse_header(file);
+			const auto elements = ply.get_elements();
+			std::shared_ptr<PlyData> vertices;
+			if (elements.front().name == "vertex") vertices = ply.request_properties_from_element("vertex", { "x", "y", "z" });
+			auto faces = ply.request_properties_from_element("face", { "vertex_indices" }, hint);
+			PlyReadOptions options;
+			options.fast_ascii = fastAscii;
+			ply.read(file, options);
+			return std::make_pair(vertices, faces);
+		};
+		auto sameData = [](const std::shared_ptr<PlyData>& a, const std::shared_ptr<PlyData>& b)
+		{
+			return a->count == b->count && a->t == b->t && a->buffer.size_bytes() == b->buffer.size_bytes() &&
+				std::memcmp(a->buffer.get(), b->buffer.get(), a->buffer.size_bytes()) == 0;
+		};
+
+		for (const char* asset : { "sofa_ascii.ply", "bunny.ply", "icosahedron_ascii.ply" })
+		{
+			const std::string path = std::string(JL_ASSETS_DIR) + "/" + asset;
+			const auto stream = readMesh(path, false, 0);
+			for (uint32_t hint : { 0, 3 })
+			{
+				const auto fast = readMesh(path, true, hint);
+				ALWAYS_ASSERT(sameData(stream.first, fast.first) && sameData(stream.second, fast.second));
+			}
+
+			PlyReadOptions options;
+			options.fast_ascii = true;
+			const auto points = ReadPoint3FromPlyFile<T>(path, options);
+			const auto expected = ReadPoint3FromPlyFile<T>(path);
+			ALWAYS_ASSERT(std::equal(points.begin(), points.end(), expected.begin(), expected.end()));
+		}
+		ALWAYS_ASSERT(sameData(readMesh("test-faces.ply", false, 0).second, readMesh("test-faces.ply", true, 0).second));
+	}
+
+	{
+		std::cout << "Test 7: Chunked read test\n";
+
+		auto readChunks = [](auto& reader, size_t chunkSize)
+		{
+			using P = std::remove_cv_t<typename std::remove_reference_t<decltype(reader.Read())>::element_type>;
+			std::vector<P> all;
+			for (auto chunk = reader.Read(); !chunk.empty(); chunk = reader.Read())
+			{
+				ALWAYS_ASSERT(chunk.size() == std::min(chunkSize, reader.Count() - all.size()));
+				all.insert(all.end(), chunk.begin(), chunk.end());
+			}
+			ALWAYS_ASSERT(reader.Position() == reader.Count() && all.size() == reader.Count());
+			return all;
+		};
+
+		{
+			Point3PlyReader<T> reader("test-binary.ply", 300);
+			ALWAYS_ASSERT(readChunks(reader, 300) == points);
+			Point3PlyReader<double> converted("test-binary.ply", 128);
+			const auto expected = ReadPoint3FromPlyFile<double>("test-binary.ply");
+			ALWAYS_ASSERT(std::equal(expected.begin(), expected.end(), readChunks(converted, 128).begin()));
+
+			size_t chunks = 0;
+			ALWAYS_ASSERT(ForEachPoint3Chunk<T>("test-binary.ply", [&](std::span<const Point<T, D>>) { ++chunks; }, 400) == points.size());
+			ALWAYS_ASSERT(chunks == 3);
+		}
+
+		// strided binary, ascii and a file already in memory
+		for (const char* asset : { "sofa.ply", "bunny.ply", "icosahedron_ascii.ply" })
+		{
+			const std::string path = std::string(JL_ASSETS_DIR) + "/" + asset;
+			const auto expected = ReadPoint3FromPlyFile<T>(path);
+			Point3PlyReader<T> reader(path, 1000);
+			ALWAYS_ASSERT(std::equal(expected.begin(), expected.end(), readChunks(reader, 1000).begin()));
+
+			std::ifstream file(path, std::ios::binary);
+			const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			Point3PlyReader<T> memory(bytes.data(), bytes.size(), 5000);
+			ALWAYS_ASSERT(std::equal(expected.begin(), expected.end(), readChunks(memory, 5000).begin()));
+		}
+
+		// lists before the vertices and in the vertex rows
+		{
+			std::vector<int32_t> faces = { 0, 1, 2, 2, 3, 0 };
+			std::vector<float> normals(2 * points.size(), 0.5f);
+			std::ofstream file("test-lists.ply", std::ios::binary);
+			PlyFile ply;
+			ply.add_properties_to_element("face", { "vertex_indices" }, Type::INT32, 2, reinterpret_cast<uint8_t*>(faces.data()), Type::UINT8, 3);
+			ply.add_properties_to_element("vertex", { "x", "y", "z" }, Type::FLOAT32, points.size(), reinterpret_cast<uint8_t*>(points.data()), Type::INVALID, 0);
+			ply.add_properties_to_element("vertex", { "uv" }, Type::FLOAT32, points.size(), reinterpret_cast<uint8_t*>(normals.data()), Type::UINT8, 2);
+			ply.write(file, true);
+		}
+		{
+			Point3PlyReader<T> reader("test-lists.ply", 333);
+			ALWAYS_ASSERT(readChunks(reader, 333) == points);
+			const auto whole = ReadPoint3FromPlyFile<T>("test-lists.ply");
+			ALWAYS_ASSERT(std::equal(whole.begin(), whole.end(), points.begin(), points.end()));
+		}
+	}
+
+	{
+		std::cout << "Test 8: Big-endian read test\n";
+
+		// enough rows for several decode threads, and a count that leaves a scalar tail after the vector swaps
+		std::vector<Point<T, D>> many(20001);
+		for (auto& p : many) p = RandomPoint<T, D>(rn, -10, 10);
+
+		// x, y, z only, and x, y, z between properties of every other width
+		{
+			std::string payload;
+			for (const auto& p : many)
+				for (size_t d = 0; d < D; ++d) AppendBigEndian(payload, p[d]);
+			std::ofstream file("test-big-endian.ply", std::ios::binary);
+			file << "ply\nformat binary_big_endian 1.0\nelement vertex " << many.size()
+				<< "\nproperty float x\nproperty float y\nproperty float z\nend_header\n" << payload;
+		}
+		{
+			std::string payload;
+			for (size_t i = 0; i < many.size(); ++i)
+			{
+				AppendBigEndian(payload, static_cast<int16_t>(static_cast<int>(i % 30000) - 15000));
+				for (size_t d = 0; d < D; ++d) AppendBigEndian(payload, many[i][d]);
+				AppendBigEndian(payload, 0.5 * static_cast<double>(i));
+				AppendBigEndian(payload, static_cast<uint8_t>(i));
+			}
+			std::ofstream file("test-big-endian-mixed.ply", std::ios::binary);
+			file << "ply\nformat binary_big_endian 1.0\nelement vertex " << many.size()
+				<< "\nproperty short id\nproperty float x\nproperty float y\nproperty float z\nproperty double w\nproperty uchar c\nend_header\n" << payload;
+		}
+
+		for (size_t threads : { 1, 4 })
+		{
+			PlyReadOptions options;
+			options.num_threads = threads;
+
+			std::ifstream file("test-big-endian-mixed.ply", std::ios::binary);
+			PlyFile ply;
+			ply.parse_header(file);
+			ALWAYS_ASSERT(ply.is_big_endian_file());
+			auto ids = ply.request_properties_from_element("vertex", { "id" });
+			auto vertices = ply.request_properties_from_element("vertex", { "x", "y", "z" });
+			auto ws = ply.request_properties_from_element("vertex", { "w" });
+			auto cs = ply.request_properties_from_element("vertex", { "c" });
+			ply.read(file, options);
+
+			ALWAYS_ASSERT(vertices->buffer.size_bytes() == many.size() * sizeof(Point<T, D>));
+			ALWAYS_ASSERT(std::memcmp(vertices->buffer.get(), many.data(), vertices->buffer.size_bytes()) == 0);
+			for (size_t i = 0; i < many.size(); ++i)
+			{
+				int16_t id;
+				double w;
+				std::memcpy(&id, ids->buffer.get() + 2 * i, 2);
+				std::memcpy(&w, ws->buffer.get() + 8 * i, 8);
+				ALWAYS_ASSERT(id == static_cast<int16_t>(static_cast<int>(i % 30000) - 15000));
+				ALWAYS_ASSERT(w == 0.5 * static_cast<double>(i));
+				ALWAYS_ASSERT(cs->buffer.get()[i] == static_cast<uint8_t>(i));
+			}
+
+			for (const char* path : { "test-big-endian.ply", "test-big-endian-mixed.ply" })
+			{
+				const auto read = ReadPoint3FromPlyFile<T>(path, options);
+				ALWAYS_ASSERT(!read.IsMapped() && std::equal(read.begin(), read.end(), many.begin(), many.end()));
+			}
+		}
+
+		for (const char* path : { "test-big-endian.ply", "test-big-endian-mixed.ply" })
+		{
+			std::vector<Point<T, D>> all;
+			ForEachPoint3Chunk<T>(path, [&](std::span<const Point<T, D>> chunk) { all.insert(all.end(), chunk.begin(), chunk.end()); }, 777);
+			ALWAYS_ASSERT(all == many);
+		}
+
+		// every value width against the scalar swap, from an odd address
+		std::vector<uint8_t> bytes(1 + 8 * 37);
+		for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<uint8_t>(i * 7);
+		for (size_t width : { 2, 4, 8 })
+		{
+			auto swapped = bytes;
+			endian_swap_values(swapped.data() + 1, (bytes.size() - 1) / width, width);
+			for (size_t i = 1; i < bytes.size(); i += width)
+				ALWAYS_ASSERT(std::equal(bytes.begin() + i, bytes.begin() + i + width, std::make_reverse_iterator(swapped.begin() + i + width)));
+		}
+	}
+
+	{
+		std::cout << "Test 9: Block write test\n";
+
+		// more than one 8 MB block of rows, each with properties of every width and a list in the middle
+		const size_t rows = 300001;
+		std::vector<int16_t> ids(rows);
+		std::vector<Point<T, D>> xyz(rows);
+		std::vector<int32_t> lists(2 * rows);
+		std::vector<double> ws(rows);
+		std::vector<uint8_t> cs(rows);
+		std::string expected;
+		for (size_t i = 0; i < rows; ++i)
+		{
+			ids[i] = static_cast<int16_t>(i);
+			xyz[i] = points[i % points.size()];
+			lists[2 * i] = static_cast<int32_t>(i);
+			lists[2 * i + 1] = -static_cast<int32_t>(i);
+			ws[i] = 0.25 * static_cast<double>(i);
+			cs[i] = static_cast<uint8_t>(i);
+
+			expected.append(reinterpret_cast<const char*>(&ids[i]), sizeof(int16_t));
+			expected.append(reinterpret_cast<const char*>(&xyz[i]), sizeof(Point<T, D>));
+			expected.push_back(2);
+			expected.append(reinterpret_cast<const char*>(&lists[2 * i]), 2 * sizeof(int32_t));
+			expected.append(reinterpret_cast<const char*>(&ws[i]), sizeof(double));
+			expected.push_back(static_cast<char>(cs[i]));
+		}
+
+		for (size_t threads : { 1, 4 })
+		{
+			{
+				PlyFile ply;
+				ply.add_properties_to_element("vertex", { "id" }, Type::INT16, rows, reinterpret_cast<uint8_t*>(ids.data()), Type::INVALID, 0);
+				ply.add_properties_to_element("vertex", { "x", "y", "z" }, Type::FLOAT32, rows, reinterpret_cast<uint8_t*>(xyz.data()), Type::INVALID, 0);
+				ply.add_properties_to_element("vertex", { "pair" }, Type::INT32, rows, reinterpret_cast<uint8_t*>(lists.data()), Type::UINT8, 2);
+				ply.add_properties_to_element("vertex", { "w" }, Type::FLOAT64, rows, reinterpret_cast<uint8_t*>(ws.data()), Type::INVALID, 0);
+				ply.add_properties_to_element("vertex", { "c" }, Type::UINT8, rows, cs.data(), Type::INVALID, 0);
+				std::ofstream file("test-block-write.ply", std::ios::binary);
+				ply.write(file, true, PlyWriteOptions{ threads });
+			}
+
+			std::ifstream file("test-block-write.ply", std::ios::binary);
+			const std::string written((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			ALWAYS_ASSERT(written.size() > expected.size());
+			ALWAYS_ASSERT(written.compare(written.size() - expected.size(), expected.size(), expected) == 0);
+			ALWAYS_ASSERT(written.compare(written.size() - expected.size() - 11, 11, "end_header\n") == 0);
+		}
+	}
+
+	{
+		std::cout << "Test 10: Fast ascii write test\n";
+
+		const size_t rows = 20001;
+		std::vector<int8_t> ids(rows);
+		std::vector<Point<T, D>> xyz(rows);
+		std::vector<uint32_t> lists(3 * rows);
+		for (size_t i = 0; i < rows; ++i)
+		{
+			ids[i] = static_cast<int8_t>(i);
+			xyz[i] = points[i % points.size()];
+			for (size_t j = 0; j < 3; ++j) lists[3 * i + j] = static_cast<uint32_t>(i * 3 + j);
+		}
+
+		auto write = [&](const char* path, const PlyWriteOptions& options)
+		{
+			PlyFile ply;
+			ply.add_properties_to_element("vertex", { "id" }, Type::INT8, rows, reinterpret_cast<uint8_t*>(ids.data()), Type::INVALID, 0);
+			ply.add_properties_to_element("vertex", { "x", "y", "z" }, Type::FLOAT32, rows, reinterpret_cast<uint8_t*>(xyz.data()), Type::INVALID, 0);
+			ply.add_properties_to_element("vertex", { "vertex_indices" }, Type::UINT32, rows, reinterpret_cast<uint8_t*>(lists.data()), Type::UINT8, 3);
+			std::ofstream file(path, std::ios::binary);
+			ply.write(file, false, options);
+		};
+		auto contents = [](const char* path)
+		{
+			std::ifstream file(path, std::ios::binary);
+			return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		};
+
+		PlyWriteOptions fast;
+		fast.fast_ascii = true;
+		write("test-ascii-fast.ply", fast);
+		fast.num_threads = 4;
+		write("test-ascii-fast-threads.ply", fast);
+		ALWAYS_ASSERT(contents("test-ascii-fast.ply") == contents("test-ascii-fast-threads.ply"));
+
+		std::ifstream file("test-ascii-fast-threads.ply", std::ios::binary);
+		PlyFile ply;
+		ply.parse_header(file);
+		auto readIds = ply.request_properties_from_element("vertex", { "id" });
+		auto readXyz = ply.request_properties_from_element("vertex", { "x", "y", "z" });
+		auto readLists = ply.request_properties_from_element("vertex", { "vertex_indices" }, 3);
+		ply.read(file);
+		ALWAYS_ASSERT(std::memcmp(readIds->buffer.get(), ids.data(), rows) == 0);
+		ALWAYS_ASSERT(std::memcmp(readXyz->buffer.get(), xyz.data(), rows * sizeof(Point<T, D>)) == 0);
+		ALWAYS_ASSERT(std::memcmp(readLists->buffer.get(), lists.data(), lists.size() * sizeof(uint32_t)) == 0);
+	}
+}
@@ -0,0 +1,94 @@
+/*
+PointCloudTest.cpp
+*/
+
+#include "JL/geometry/Random.h"
+#include "JL/geometry/PointCloud.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace jl;
+
+void TestPointCloud()
+{
+    std::cout << "##### Point Cloud Test #####\n";
+
+    using T = float;
+    const size_t D = 3;
+    const T min = -10;
+    const T max = 10;
+
+    auto reng = GetRandomEngine();
+
+    // crosses a Normalise block and leaves a scalar tail for every vector width
+    const size_t count = 2500;
+    std::vector<Point<T, D>> points(count);
+    for (auto& p : points) p = RandomPoint<T, D>(reng, min, max);
+
+    // AoS <-> SoA
+    {
+        std::cout << "Test 1: Conversion test\n";
+
+        PointCloud<T, D> cloud(points);
+        ALWAYS_ASSERT(cloud.size() == count);
+        for (size_t d = 0; d < D; ++d)
+            ALWAYS_ASSERT(reinterpret_cast<uintptr_t>(cloud.data(d)) % CacheLineSize == 0);
+        for (size_t i = 0; i < count; ++i)
+            ALWAYS_ASSERT(cloud[i] == points[i] && cloud.data(1)[i] == points[i][1]);
+        ALWAYS_ASSERT(cloud.ToPoints() == points);
+
+        PointCloud<T, D> pushed;
+        for (auto& p : points) pushed.push_back(p);
+        ALWAYS_ASSERT(pushed == cloud);
+
+        pushed.Set(7, Zero<T, D>());
+        ALWAYS_ASSERT(pushed[7] == (Zero<T, D>()) && pushed != cloud);
+    }
+
+    // Bulk operations against the per point operators, at every instruction set the CPU supports
+    {
+        std::cout << "Test 2: Bulk operations test\n";
+
+        const auto detected = simd::DetectSimdLevel();
+        for (int level = 0; level <= static_cast<int>(detected); ++level)
+        {
+            simd::SetSimdLevel(static_cast<simd::SimdLevel>(level));
+
+            const auto offset = RandomPoint<T, D>(reng, min, max);
+            const auto v = RandomPoint<T, D>(reng, min, max);
+            const T s = 1.5f;
+
+            PointCloud<T, D> cloud(points);
+            Translate(cloud, offset);
+            for (size_t i = 0; i < count; ++i) ALWAYS_ASSERT(cloud[i] == points[i] + offset);
+
+            cloud = PointCloud<T, D>(points);
+            Scale(cloud, s);
+            for (size_t i = 0; i < count; ++i) ALWAYS_ASSERT(cloud[i] == points[i] * s);
+
+            cloud = PointCloud<T, D>(points);
+            Scale(cloud, v);
+            for (size_t i = 0; i < count; ++i) ALWAYS_ASSERT(cloud[i] == ComponentMultiply(points[i], v));
+
+            cloud = PointCloud<T, D>(points);
+            std::vector<T> out(count);
+            DotProduct(cloud, v, out.data());
+            for (size_t i = 0; i < count; ++i) ALWAYS_ASSERT(out[i] == DotProduct(points[i], v));
+
+            MagnitudeSquare(cloud, out.data());
+            for (size_t i = 0; i < count; ++i) ALWAYS_ASSERT(out[i] == MagnitudeSquare(points[i]));
+
+            Magnitude(cloud, out.data());
+            for (size_t i = 0; i < count; ++i) ALWAYS_ASSERT(out[i] == Magnitude(points[i]));
+
+            Normalise(cloud);
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto p = points[i];
+                ALWAYS_ASSERT(cloud[i] == Normalise(p));
+            }
+        }
+        simd::SetSimdLevel(detected);
+    }
+}
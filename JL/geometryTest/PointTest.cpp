@@ -6,6 +6,7 @@ PointTest.cpp
 #include "JL/geometry/Point.h"
 
 #include <iostream>
+#include <vector>
 
 # define PI 3.14159265358979323846
 
@@ -137,4 +138,115 @@ void TestPoint()
             ALWAYS_ASSERT(angle2 == angle1);
         }
     }
-}
\ No newline at end of file
+
+    // Bulk operations
+    {
+        std::cout << "Test 5: Bulk operations test\n";
+
+        // every instruction set the CPU supports has to agree with the per point operators
+        const auto detected = simd::DetectSimdLevel();
+        for (int level = 0; level <= static_cast<int>(detected); ++level)
+        {
+            simd::SetSimdLevel(static_cast<simd::SimdLevel>(level));
+
+            // odd count so that the scalar tail of every vector width is exercised
+            const size_t count = 1001;
+            std::vector<Point<T, D>> a(count), b(count), out(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                a[i] = RandomPoint<T, D>(reng, min, max);
+                b[i] = RandomPoint<T, D>(reng, min, max);
+            }
+
+            Add(a.data(), b.data(), out.data(), count);
+            for (size_t i = 0; i < count; ++i) ALWAYS_ASSERT(out[i] == a[i] + b[i]);
+
+            Subtract(a.data(), b.data(), out.data(), count);
+            for (size_t i = 0; i < count; ++i) ALWAYS_ASSERT(out[i] == a[i] - b[i]);
+
+            ComponentMultiply(a.data(), b.data(), out.data(), count);
+            for (size_t i = 0; i < count; ++i) ALWAYS_ASSERT(out[i] == ComponentMultiply(a[i], b[i]));
+
+            T s = rnInt32(reng);
+            Scale(a.data(), s, out.data(), count);
+            for (size_t i = 0; i < count; ++i) ALWAYS_ASSERT(out[i] == a[i] * s);
+
+            // in place
+            out = a;
+            Add(out.data(), b.data(), out.data(), count);
+            for (size_t i = 0; i < count; ++i) ALWAYS_ASSERT(out[i] == a[i] + b[i]);
+
+            // points wide enough to take the vectorised path on their own
+            {
+                const size_t W = 45;
+                auto p = RandomPoint<T, W>(reng, min, max);
+                auto q = RandomPoint<T, W>(reng, min, max);
+
+                T sum = 0;
+                for (size_t i = 0; i < W; ++i) sum += p[i] * q[i];
+                ALWAYS_ASSERT(DotProduct(p, q) == sum);
+
+                auto r = p + q;
+                for (size_t i = 0; i < W; ++i) ALWAYS_ASSERT(r[i] == p[i] + q[i]);
+            }
+            {
+                using F = float;
+                const size_t W = 45;
+                auto p = RandomPoint<F, W>(reng, -1.0f, 1.0f);
+                auto q = RandomPoint<F, W>(reng, -1.0f, 1.0f);
+
+                F sum = 0;
+                for (size_t i = 0; i < W; ++i) sum += p[i] * q[i];
+                // the vector sum is reassociated across lanes
+                ALWAYS_ASSERT(std::abs(DotProduct(p, q) - sum) <= 1e-5f);
+            }
+        }
+        simd::SetSimdLevel(detected);
+    }
+
+    // Lazy expressions
+    {
+        std::cout << "Test 6: Lazy expression test\n";
+
+        for (size_t i = 0; i < 100; ++i)
+        {
+            auto a = RandomPoint<T, D>(reng, min, max);
+            auto b = RandomPoint<T, D>(reng, min, max);
+            auto c = RandomPoint<T, D>(reng, min, max);
+            T s = rnInt32(reng);
+            if (s == 0) ++s;
+
+            Point<T, D> r = Evaluate(Lazy(a) + b - Lazy(c) * s);
+            ALWAYS_ASSERT(r == a + b - c * s);
+            ALWAYS_ASSERT(Evaluate(s * (Lazy(a) - b) / s) == (s * (a - b)) / s);
+
+            auto negated = c;
+            ALWAYS_ASSERT(Evaluate(-Lazy(c)) == -negated);
+
+            // the destination is also an operand
+            auto expected = a * s + b;
+            Assign(a, Lazy(a) * s + b);
+            ALWAYS_ASSERT(a == expected);
+        }
+    }
+
+    // constexpr
+    {
+        std::cout << "Test 7: Compile time test\n";
+
+        constexpr Point3i x{ 1, 0, 0 };
+        constexpr Point3i y{ 0, 1, 0 };
+        static_assert(CrossProduct(x, y) == Point3i{ 0, 0, 1 });
+        static_assert(CrossProduct(Point2i{ 1, 2 }, Point2i{ 3, 4 }) == -2);
+        static_assert(ScalarTripleProduct(x, y, CrossProduct(x, y)) == 1);
+        static_assert(DotProduct(x + y, UnitPoint<T, 3>()) == 2);
+        static_assert(MagnitudeSquare(Repeat<T, 3>(2) * 3 - y) == 97);
+
+        // wide enough that the same calls take the Simd.h kernels at run time
+        constexpr auto wide = Repeat<float, 32>(1.5f) + UnitPoint<float, 32>();
+        static_assert(DotProduct(wide, wide) == 200.0f);
+        auto runtime = wide;
+        ALWAYS_ASSERT(DotProduct(runtime, runtime) == 200.0f);
+        ALWAYS_ASSERT((ComponentMultiply(runtime, runtime) == Repeat<float, 32>(6.25f)));
+    }
+}
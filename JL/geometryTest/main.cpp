@@ -5,6 +5,7 @@ main.cpp
 #include <iostream>
 
 void TestPoint();
+void TestPointCloud();
 void TestInifiniteRegularGrid();
 
 void TestPly();
@@ -12,7 +13,8 @@ void TestPly();
 
 int main()
 {
-    //TestPoint();
+    TestPoint();
+    TestPointCloud();
     //TestInifiniteRegularGrid();
     TestPly();
 
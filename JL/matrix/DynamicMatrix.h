@@ -0,0 +1,101 @@
+/*
+DynamicMatrix.h
+
+Matrix whose size is only known at run time (e.g. read from a file). Elements are row-major in cache
+line aligned heap storage, so large matrices do not live on the stack.
+
+It supports the operators of Matrix.h and uses the same GEMM, SIMD and LU kernels. Dimensions are
+checked with ALWAYS_ASSERT, because unlike Matrix they cannot be checked at compile time.
+
+A DynamicMatrix can only be moved. Copying would allocate, so use Clone() to make a copy. Convert
+from and to Matrix with the explicit constructor and ToMatrix<M,N>(), so small fixed-size code keeps
+its zero allocation path.
+*/
+
+#pragma once
+
+#include "JL/matrix/Matrix.h"
+#include "JL/utils/AlignedAllocator.h"
+
+#include <initializer_list>
+#include <iostream>
+#include <vector>
+
+namespace jl
+{
+    template <typename T>
+    struct DynamicMatrix
+    {
+        using Storage = std::vector<T, AlignedAllocator<T>>;
+        using CoordType = T;
+
+        Storage Elements;
+        size_t Rows = 0;
+        size_t Columns = 0;
+
+        DynamicMatrix() = default;
+        // value initialised (zero) rows x columns matrix
+        DynamicMatrix(size_t rows, size_t columns);
+        DynamicMatrix(size_t rows, size_t columns, std::initializer_list<T> values);
+        template<size_t M, size_t N> explicit DynamicMatrix(const Matrix<T,M,N>& a);
+
+        DynamicMatrix(DynamicMatrix&&) noexcept = default;
+        DynamicMatrix& operator=(DynamicMatrix&&) noexcept = default;
+        DynamicMatrix(const DynamicMatrix&) = delete;
+        DynamicMatrix& operator=(const DynamicMatrix&) = delete;
+
+        DynamicMatrix Clone() const;
+        template<size_t M, size_t N> Matrix<T,M,N> ToMatrix() const;
+
+        size_t size() const { return Elements.size(); }
+        size_t NumColumns() const { return Columns; }
+        size_t NumRows() const { return Rows; }
+        T* data() { return Elements.data(); }
+        const T* data() const { return Elements.data(); }
+        T& operator[](size_t i) { return Elements[i]; }
+        const T& operator[](size_t i) const { return Elements[i]; }
+        T& operator()(size_t row, size_t column) { return Elements[row*Columns+column]; }
+        const T& operator()(size_t row, size_t column) const { return Elements[row*Columns+column]; }
+    };
+
+    template<typename T> std::ostream& operator<<(std::ostream& os, const DynamicMatrix<T>& a);
+
+    template<typename T> DynamicMatrix<T> operator+(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs);
+    template<typename T> DynamicMatrix<T> operator-(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs);
+    template<typename T> DynamicMatrix<T> operator*(const DynamicMatrix<T>& lhs, T s);
+    template<typename T> DynamicMatrix<T> operator*(T s, const DynamicMatrix<T>& rhs);
+    template<typename T> DynamicMatrix<T> operator/(const DynamicMatrix<T>& lhs, T s);
+    template<typename T> DynamicMatrix<T>& operator+=(DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs);
+    template<typename T> DynamicMatrix<T>& operator-=(DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs);
+    template<typename T> DynamicMatrix<T>& operator*=(DynamicMatrix<T>& lhs, T s);
+    template<typename T> DynamicMatrix<T>& operator/=(DynamicMatrix<T>& lhs, T s);
+
+    // lhs.NumColumns() == rhs.NumRows(), mixed with Matrix on either side without converting it
+    template<typename T> DynamicMatrix<T> operator*(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs);
+    template<typename T, size_t M, size_t N> DynamicMatrix<T> operator*(const Matrix<T,M,N>& lhs, const DynamicMatrix<T>& rhs);
+    template<typename T, size_t M, size_t N> DynamicMatrix<T> operator*(const DynamicMatrix<T>& lhs, const Matrix<T,M,N>& rhs);
+    // lhs * rhs on up to numThreads threads (0 for every hardware thread), see ParallelMultiply in Matrix.h
+    template<typename T> DynamicMatrix<T> ParallelMultiply(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs, size_t numThreads = 0);
+    // c = alpha * lhs * rhs + beta * c in place, see MultiplyAdd in Matrix.h. c keeps its storage, a one column rhs is a GEMV.
+    template<typename T> void MultiplyAdd(DynamicMatrix<T>& c, const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs,
+        std::type_identity_t<T> alpha = 1, std::type_identity_t<T> beta = 1, size_t numThreads = 1);
+
+    // matrices of different sizes are not equal
+    template<typename T> bool operator==(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs);
+    template<typename T> bool operator!=(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs);
+
+    template<typename T> DynamicMatrix<T> Transpose(const DynamicMatrix<T>& a);
+    // Square matrices only
+    template<typename T> DynamicMatrix<T>& TransposeInPlace(DynamicMatrix<T>& a);
+    // a^T without copying a, see TransposedView in Matrix.h
+    template<typename T> TransposedView<DynamicMatrix<T>> Transposed(const DynamicMatrix<T>& a);
+    template<typename T> DynamicMatrix<T> operator*(TransposedView<DynamicMatrix<T>> lhs, const DynamicMatrix<T>& rhs);
+    template<typename T> DynamicMatrix<T> operator*(const DynamicMatrix<T>& lhs, TransposedView<DynamicMatrix<T>> rhs);
+    // Closed form up to 4x4, LU decomposition (floating point) or Bareiss elimination (integers) above
+    template<typename T> T Determinant(const DynamicMatrix<T>& a);
+    // In place, floating point only, a must not be singular
+    template<typename T> DynamicMatrix<T>& InverseMatrix(DynamicMatrix<T>& a);
+
+}
+
+#include "detail/DynamicMatrix.inl"
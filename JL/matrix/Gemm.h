@@ -0,0 +1,111 @@
+/*
+Gemm.h
+
+General matrix multiplication (GEMM) kernels behind Matrix operator*.
+
+All kernels work on row-major storage addressed by a pointer and a leading dimension (the distance,
+in elements, between two consecutive rows), so they can be used on a whole matrix or on a sub-block
+of a larger one. Following the naming in Matrix.h:
+    a = M x N, b = N x P, c = a * b = M x P
+
+GemmSmall covers every size up to 4 x 4 x 4 (transform composition) of tightly packed matrices, with the
+sizes as template parameters and fully unrolled. For float and double with 4 columns in b, each row of c is built from broadcasts of a row
+of a times the rows of b in SSE/AVX registers:
+    c.row(m) = a(m,0) * b.row(0) + a(m,1) * b.row(1) + ... + a(m,N-1) * b.row(N-1)
+
+GemmBlocked follows the GotoBLAS/BLIS layering:
+    1. b is cut into KC x NC panels which are packed into NR wide column strips (lives in L2/L3)
+    2. a is cut into MC x KC blocks which are packed into MR tall row strips (lives in L2)
+    3. a register blocked MR x NR micro-kernel walks one a strip against one b strip (lives in L1)
+
+GemmNaive and GemmBlocked also take a and b through a row stride and a column stride (element (i, k) of a is
+a[i*rsa + k*csa]): a transposed operand is read by swapping the two, and the packing step lays it out like any
+other, so a^T * a costs no transpose.
+
+The transpose kernels walk TransposeBlockSize squares, so the rows read from a and the rows written to the
+transpose both stay in cache instead of striding through memory for every element.
+
+GemmParallel cuts c into GemmTileRows x GemmTileColumns tiles and runs GemmBlocked on each tile as a task of
+ThreadPool::Shared(), so idle threads steal tiles from busy ones. Every tile packs its own panels of a and b
+(a few percent of the flops) and no two tasks write the same element of c, so the threads never synchronise
+inside the product. The tiles use the same order of accumulation, the result does not depend on the thread count.
+
+The overloads taking alpha and beta compute c = alpha * a * b + beta * c in place (MultiplyAdd in Matrix.h and
+DynamicMatrix.h), without a temporary for a * b. As in BLAS, c is not read when beta is 0. The blocked kernel
+applies alpha and beta once per element of c when it stores the register block, Gemv is the P = 1 case with
+contiguous b and c.
+
+Tolerance:
+    A plain product a * b is accumulated in the same order as GemmNaive (k = 0, 1, ..., N-1 starting
+    from zero) for every N, and so is alpha * a * b + beta * c for N <= KC, with beta * c added last.
+    Deeper products with alpha and beta cannot keep the running sum in c: each KC panel adds alpha times
+    its own sum to c, which rounds differently from GemmNaive. Integer results are identical either way,
+    and floating point results in GemmNaive's order are bitwise identical as long as the compiler makes
+    the same multiply-add contraction (FMA) decisions for both loops.
+    Otherwise the usual summation bound applies: |c - c'| <= 2 * (N + 1) * eps * (|alpha| sum(|a||b|) + |beta c|).
+*/
+
+#pragma once
+
+#include <cstddef>
+
+namespace jl
+{
+    namespace detail
+    {
+        template<typename T>
+        struct GemmBlocking
+        {
+            static constexpr size_t MR = 4;     // rows of the register block
+            static constexpr size_t NR = 8;     // columns of the register block
+            static constexpr size_t MC = 64;    // rows of a packed block of a
+            static constexpr size_t KC = 256;   // depth of a packed block of a / panel of b
+            static constexpr size_t NC = 512;   // columns of a packed panel of b
+        };
+
+        // operator* uses GemmBlocked once M*N*P reaches this size, smaller products are cheaper without packing
+        constexpr size_t GemmBlockedThreshold = 32 * 32 * 32;
+
+        // operator* uses GemmSmall when M, N and P are all at most this
+        constexpr size_t GemmSmallMax = 4;
+
+        // GemmParallel stays on the calling thread below this M*N*P, starting the workers costs more
+        constexpr size_t GemmParallelThreshold = 128 * 128 * 128;
+        // Size of the tiles of c handed out by GemmParallel
+        constexpr size_t GemmTileRows = 128;
+        constexpr size_t GemmTileColumns = 256;
+
+        template<typename T, size_t M, size_t N, size_t P> inline void GemmSmall(const T* a, const T* b, T* c);
+        template<typename T> constexpr void GemmNaive(size_t M, size_t N, size_t P, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc);
+        template<typename T> void GemmBlocked(size_t M, size_t N, size_t P, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc);
+        // Picks one of the two at run time, for sizes that are not known at compile time
+        template<typename T> void Gemm(size_t M, size_t N, size_t P, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc);
+        // Gemm on up to numThreads threads (0 for every hardware thread)
+        template<typename T> void GemmParallel(size_t M, size_t N, size_t P, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, size_t numThreads);
+
+        // c = alpha * a * b + beta * c
+        template<typename T> constexpr void GemmNaive(size_t M, size_t N, size_t P, T alpha, const T* a, size_t lda, const T* b, size_t ldb, T beta, T* c, size_t ldc);
+        template<typename T> void GemmBlocked(size_t M, size_t N, size_t P, T alpha, const T* a, size_t lda, const T* b, size_t ldb, T beta, T* c, size_t ldc);
+        template<typename T> void Gemm(size_t M, size_t N, size_t P, T alpha, const T* a, size_t lda, const T* b, size_t ldb, T beta, T* c, size_t ldc);
+        template<typename T> void GemmParallel(size_t M, size_t N, size_t P, T alpha, const T* a, size_t lda, const T* b, size_t ldb, T beta, T* c, size_t ldc, size_t numThreads);
+        // y = alpha * a * x + beta * y, a is M x N, x and y are contiguous
+        template<typename T> constexpr void Gemv(size_t M, size_t N, T alpha, const T* a, size_t lda, const T* x, T beta, T* y);
+
+        // c = alpha * a * b + beta * c with element (i, k) of a at a[i*rsa + k*csa] and element (k, j) of b at b[k*rsb + j*csb]
+        template<typename T> constexpr void GemmNaive(size_t M, size_t N, size_t P, T alpha, const T* a, size_t rsa, size_t csa, const T* b, size_t rsb, size_t csb, T beta, T* c, size_t ldc);
+        template<typename T> void GemmBlocked(size_t M, size_t N, size_t P, T alpha, const T* a, size_t rsa, size_t csa, const T* b, size_t rsb, size_t csb, T beta, T* c, size_t ldc);
+
+        // Side of the squares visited by the transpose kernels, and the size (M*N) from which Transpose uses them
+        constexpr size_t TransposeBlockSize = 32;
+        constexpr size_t TransposeBlockedThreshold = 64 * 64;
+
+        // t (N x M) = a (M x N)^T, t must not overlap a
+        template<typename T> constexpr void TransposeBlocked(size_t M, size_t N, const T* a, size_t lda, T* t, size_t ldt);
+        // a (N x N) = a^T
+        template<typename T> constexpr void TransposeSquareInPlace(size_t N, T* a, size_t lda);
+
+    } // namespace detail
+
+} // namespace jl
+
+#include "detail/Gemm.inl"
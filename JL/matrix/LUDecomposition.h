@@ -0,0 +1,60 @@
+/*
+LUDecomposition.h
+
+https://en.wikipedia.org/wiki/LU_decomposition
+
+PA = LU where,
+    P = permutation matrix (the row swaps chosen by partial pivoting)
+    L = unit lower triangular matrix
+    U = upper triangular matrix
+
+L and U share one matrix: L is stored below the diagonal (its unit diagonal is implied) and U on and
+above it. Once decomposed, the determinant is the product of the diagonal of U (negated for an odd
+number of row swaps), Ax = b is solved with one forward and one backward substitution and the inverse
+is the solution of AX = I.
+
+The decomposition divides, so it is only defined for floating point matrices. Integer matrices get an
+exact determinant from DeterminantBareiss, the fraction-free variant of the same elimination.
+*/
+
+#pragma once
+
+#include "JL/matrix/Matrix.h"
+#include "JL/geometry/Point.h"
+
+namespace jl
+{
+    template <typename T, size_t N>
+    struct LUDecomposition
+    {
+        Matrix<T,N,N> LU;
+        std::array<size_t,N> Pivots;    // row i of LU comes from row Pivots[i] of the decomposed matrix
+        int PivotSign;                  // +1 for an even number of row swaps, -1 for an odd number
+        bool IsSingular;
+    };
+
+    template<typename T, size_t N> LUDecomposition<T,N> LUDecompose(const Matrix<T,N,N>& a);
+    template<typename T, size_t N> T Determinant(const LUDecomposition<T,N>& lu);
+    // x such that Ax = b
+    template<typename T, size_t N> Point<T,N> Solve(const LUDecomposition<T,N>& lu, const Point<T,N>& b);
+    template<typename T, size_t N> Matrix<T,N,N> Inverse(const LUDecomposition<T,N>& lu);
+
+    template<typename T, size_t N> T DeterminantBareiss(const Matrix<T,N,N>& a);
+
+    namespace detail
+    {
+        // Runtime sized kernels on a row-major n x n matrix
+
+        // Decomposes a in place. Returns the pivot sign, or 0 if a is singular.
+        template<typename T> int LUFactor(T* a, size_t n, size_t* pivots);
+        template<typename T> T LUDeterminant(const T* lu, size_t n, int pivotSign);
+        // Solves LUx = Pb, b and x must not overlap
+        template<typename T> void LUSolve(const T* lu, size_t n, const size_t* pivots, const T* b, T* x);
+        // Solves LUX = P, a whole row of X at a time. lu and inverse must not overlap.
+        template<typename T> void LUInverse(const T* lu, size_t n, const size_t* pivots, T* inverse);
+        // Integer types are eliminated in 64 bit to keep the intermediate products exact
+        template<typename T> T BareissDeterminant(const T* a, size_t n);
+    }
+}
+
+#include "detail/LUDecomposition.inl"
@@ -8,25 +8,95 @@ Av = T(v) where,
     v = vector
     T(v) = Transformed vector
 
-Linear transformation keep the origin fixed.
+Linear transformation keep the origin fixed: scaling, rotation, shearing and reflection below.
 
+An affine transformation (e.g. a rotation followed by a translation) is a D+1 x D+1 matrix in homogeneous
+coordinates, the point is extended with a 1:
+
+    | A t | | v |   | Av + t |
+    | 0 1 | | 1 | = |   1    |
+
+Points are transformed one at a time or in batches. A batch of points is one tight loop over a local copy of
+the matrix that the compiler vectorises. A PointCloud is already one array per coordinate and goes through the
+vectorised kernels of Simd.h in blocks, which is the fastest layout to transform. Batches are split across
+numThreads threads (0 for every hardware thread) when they are large enough.
+
+Every path sums in the same order with a rounding per operation (the Simd.h kernels are built without FMA
+contraction), so batches and PointCloud give the per point Transform bit for bit. Code compiled with FMA
+contraction enabled (e.g. GCC with -march=native) may fuse the per point loops and differ in the last bits.
 */
 
 #pragma once
 
 #include "JL/matrix/Matrix.h"
 #include "JL/geometry/Point.h"
+#include "JL/geometry/PointCloud.h"
+
+#include <span>
 
 namespace jl
 {
-    template<typename T, size_t D> Matrix<T, D, D> ScaleMatrix(T factor);
+    //////////////////////////// Builders
+
+    // Every builder except the ones taking an angle can be evaluated at compile time. Angles are in radians,
+    // counter clockwise when looking down the axis towards the origin.
+
+    // factor * I
+    template<typename T, size_t D> constexpr Matrix<T,D,D> ScaleMatrix(T factor);
+    // Coordinate d is scaled by factors[d]
+    template<typename T, size_t D> constexpr Matrix<T,D,D> ScaleMatrix(const Point<T,D>& factors);
+
+    // 2D rotation, from the angle or from its cosine and sine
+    template<typename T> Matrix<T,2,2> RotationMatrix(T angle);
+    template<typename T> constexpr Matrix<T,2,2> RotationMatrix(T cosine, T sine);
+    // 3D rotation about a unit axis (Rodrigues' formula), from the angle or from its cosine and sine
+    template<typename T> Matrix<T,3,3> RotationMatrix(const Point<T,3>& axis, T angle);
+    template<typename T> constexpr Matrix<T,3,3> RotationMatrix(const Point<T,3>& axis, T cosine, T sine);
+
+    // Identity plus factor at (row, column): coordinate row gains factor * coordinate column. row != column
+    template<typename T, size_t D> constexpr Matrix<T,D,D> ShearMatrix(size_t row, size_t column, T factor);
+    // Reflection through the hyperplane through the origin with the unit normal n: I - 2 n n^T
+    template<typename T, size_t D> constexpr Matrix<T,D,D> ReflectionMatrix(const Point<T,D>& normal);
+
+    // Homogeneous D+1 x D+1 matrices
+    template<typename T, size_t D> constexpr Matrix<T,D+1,D+1> TranslationMatrix(const Point<T,D>& offset);
+    // linear followed by a move by offset
+    template<typename T, size_t D> constexpr Matrix<T,D+1,D+1> AffineMatrix(const Matrix<T,D,D>& linear, const Point<T,D>& offset = {});
+
+    //////////////////////////// Composition
+
+    /*
+    Products that skip the entries known to be 0 or 1 instead of a dense multiply. As with operator*,
+    the rhs is applied first.
+
+        ComposeAffine(a, b)     a * b of two affine matrices, the last rows are not read (D^3 + D^2 instead of (D+1)^3)
+        Scaled(a, factors)      ScaleMatrix(factors) * a, scales the first D rows (D x D or D+1 x D+1 a)
+        Translated(a, offset)   TranslationMatrix(offset) * a, adds offset to the last column of an affine a
+    */
+    template<typename T, size_t N> constexpr Matrix<T,N,N> ComposeAffine(const Matrix<T,N,N>& a, const Matrix<T,N,N>& b);
+    template<typename T, size_t N, size_t D> constexpr Matrix<T,N,N> Scaled(const Matrix<T,N,N>& a, const Point<T,D>& factors);
+    template<typename T, size_t D> constexpr Matrix<T,D+1,D+1> Translated(const Matrix<T,D+1,D+1>& a, const Point<T,D>& offset);
+
+    //////////////////////////// Transform
+
+    // A * p
+    template<typename T, size_t D> constexpr Point<T,D> Transform(const Matrix<T,D,D>& a, const Point<T,D>& p);
+    // Affine: the upper left D x D block of a times p plus the last column of a. The last row of a is taken to be (0, ..., 0, 1).
+    template<typename T, size_t D> constexpr Point<T,D> Transform(const Matrix<T,D+1,D+1>& a, const Point<T,D>& p);
+
+    // out[i] = Transform(a, in[i]) for `count` points, out may be in
+    template<typename T, size_t D> void Transform(const Matrix<T,D,D>& a, const Point<T,D>* in, Point<T,D>* out, size_t count, size_t numThreads = 1);
+    template<typename T, size_t D> void Transform(const Matrix<T,D+1,D+1>& a, const Point<T,D>* in, Point<T,D>* out, size_t count, size_t numThreads = 1);
+    // a is D x D or D+1 x D+1, in and out have the same size
+    template<typename T, size_t N, size_t D> void Transform(const Matrix<T,N,N>& a, std::span<const Point<T,D>> in, std::span<Point<T,D>> out, size_t numThreads = 1);
 
-    //////////////////////////// Implementation
+    // y = alpha * A * x + beta * y in place (GEMV), y must not be x
+    template<typename T, size_t M, size_t N> constexpr void MultiplyAdd(Point<T,M>& y, const Matrix<T,M,N>& a, const Point<T,N>& x,
+        std::type_identity_t<T> alpha = 1, std::type_identity_t<T> beta = 1);
 
-    template<typename T, size_t D> 
-    Matrix<T, D, D> ScaleMatrix(T factor)
-    {
+    // Every point of the cloud in place, a is D x D or D+1 x D+1
+    template<typename T, size_t N, size_t D> PointCloud<T,D>& Transform(const Matrix<T,N,N>& a, PointCloud<T,D>& cloud, size_t numThreads = 1);
 
-    }
+}
 
-}
\ No newline at end of file
+#include "detail/LinearTransformation.inl"
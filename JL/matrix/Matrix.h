@@ -5,6 +5,11 @@ Matrix.h
 #pragma once
 
 #include <iostream>
+#include <array>
+#include <type_traits>
+
+// Lazy(), Evaluate() and Assign() fuse chains of elementwise operators into one loop
+#include "JL/utils/Expression.h"
 
 namespace jl
 {
@@ -22,48 +27,95 @@ namespace jl
         Coords Elements;
 
         template <typename... Values>
-        Matrix(Values... values) : Elements(std::array<T,M*N>({ std::forward<Values>(values)... }))
+        constexpr Matrix(Values... values) : Elements(std::array<T,M*N>({ std::forward<Values>(values)... }))
         {}
 
-        const size_t size() const { return Elements.size(); }
-        const size_t NumColumns() const { return N; }
-        const size_t NumRows() const { return M; }
-        T& operator[](size_t i) { return Elements[i]; }
-        const T& operator[](size_t i) const { return Elements[i]; }
+        constexpr size_t size() const { return Elements.size(); }
+        constexpr size_t NumColumns() const { return N; }
+        constexpr size_t NumRows() const { return M; }
+        constexpr T& operator[](size_t i) { return Elements[i]; }
+        constexpr const T& operator[](size_t i) const { return Elements[i]; }
     };
     
     template<typename T, size_t M, size_t N> std::ostream& operator<<(std::ostream& os, const Matrix<T,M,N>& a);
 
-    template<typename T, size_t M, size_t N> Matrix<T,M,N> operator+(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs);
-    template<typename T, size_t M, size_t N> Matrix<T,M,N> operator-(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs);
-    template<typename T, size_t M, size_t N> Matrix<T,M,N> operator*(const Matrix<T,M,N>& lhs, T s);
-    template<typename T, size_t M, size_t N> Matrix<T,M,N> operator*(T s, const Matrix<T, N, N>& rhs);
-    template<typename T, size_t M, size_t N> Matrix<T,M,N> operator/(const Matrix<T,M,N>& lhs, T s);
-    template<typename T, size_t M, size_t N> Matrix<T,M,N>& operator+=(Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs);
-    template<typename T, size_t M, size_t N> Matrix<T,M,N>& operator-=(Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs);
-    template<typename T, size_t M, size_t N> Matrix<T,M,N>& operator*=(Matrix<T,M,N>& lhs, T s);
-    template<typename T, size_t M, size_t N> Matrix<T,M,N>& operator/=(Matrix<T,M,N>& lhs, T s);
+    /*
+    The operators and functions marked constexpr can build matrices at compile time, e.g.
+        constexpr auto a = IdentityMatrix<float,4,4>() * 2.0f;
+    Under constant evaluation they run plain loops; at run time the same calls use the Simd.h kernels and
+    the blocked GEMM. Determinant is constexpr up to 4x4, the LU and Bareiss paths above that are run time only.
+    */
+
+    template<typename T, size_t M, size_t N> constexpr Matrix<T,M,N> operator+(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs);
+    template<typename T, size_t M, size_t N> constexpr Matrix<T,M,N> operator-(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs);
+    template<typename T, size_t M, size_t N> constexpr Matrix<T,M,N> operator*(const Matrix<T,M,N>& lhs, T s);
+    template<typename T, size_t M, size_t N> constexpr Matrix<T,M,N> operator*(T s, const Matrix<T,M,N>& rhs);
+    template<typename T, size_t M, size_t N> constexpr Matrix<T,M,N> operator/(const Matrix<T,M,N>& lhs, T s);
+    template<typename T, size_t M, size_t N> constexpr Matrix<T,M,N>& operator+=(Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs);
+    template<typename T, size_t M, size_t N> constexpr Matrix<T,M,N>& operator-=(Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs);
+    template<typename T, size_t M, size_t N> constexpr Matrix<T,M,N>& operator*=(Matrix<T,M,N>& lhs, T s);
+    template<typename T, size_t M, size_t N> constexpr Matrix<T,M,N>& operator/=(Matrix<T,M,N>& lhs, T s);
     /*
     Rule of thumb for matrix multiplication:
         1. A1.N == A2.M (e.g. a(m x n) * a(n x p) = a(m x p)
         2. NOT commutative (e.g. AB != BA)
         3. Any matrix can be multiplied element-wise by a scalar from its associated field
+    Large products (M*N*P >= detail::GemmBlockedThreshold) go through the cache blocked kernel in Gemm.h,
+    products up to 4 x 4 x 4 through the unrolled GemmSmall.
+    */
+    template<typename T, size_t M, size_t N, size_t P> constexpr Matrix<T,M,P> operator*(const Matrix<T,M,N>& a1, const Matrix<T,N,P>& a2);
+    // a1 * a2 on up to numThreads threads (0 for every hardware thread), for products of a few hundred per side and
+    // more. operator* stays on the calling thread, the result is the same for any number of threads.
+    template<typename T, size_t M, size_t N, size_t P> Matrix<T,M,P> ParallelMultiply(const Matrix<T,M,N>& a1, const Matrix<T,N,P>& a2, size_t numThreads = 0);
+    /*
+    a^T without copying a, for products with a transposed operand: Transposed(a) * a is a^T a and a * Transposed(b)
+    is a b^T. The GEMM kernels read a through swapped strides while packing it. The view refers to a, which must
+    outlive it.
+    */
+    template<typename A>
+    struct TransposedView
+    {
+        const A& Source;
+    };
+
+    template<typename T, size_t M, size_t N> constexpr TransposedView<Matrix<T,M,N>> Transposed(const Matrix<T,M,N>& a);
+    template<typename T, size_t M, size_t N, size_t P> constexpr Matrix<T,N,P> operator*(TransposedView<Matrix<T,M,N>> a1, const Matrix<T,M,P>& a2);
+    template<typename T, size_t M, size_t N, size_t P> constexpr Matrix<T,M,P> operator*(const Matrix<T,M,N>& a1, TransposedView<Matrix<T,P,N>> a2);
+
+    /*
+    c = alpha * a1 * a2 + beta * c, written straight into c instead of through a temporary product, so
+    c += a1 * a2 is MultiplyAdd(c, a1, a2). c must not be a1 or a2. With beta 0 c is only written.
+    A single column a2 (P == 1) is a matrix vector product (GEMV). Large products split across numThreads threads
+    like ParallelMultiply.
     */
-    template<typename T, size_t M, size_t N, size_t P> Matrix<T,M,P> operator*(const Matrix<T,M,N>& a1, const Matrix<T,N,P>& a2);
+    template<typename T, size_t M, size_t N, size_t P> void MultiplyAdd(Matrix<T,M,P>& c, const Matrix<T,M,N>& a1, const Matrix<T,N,P>& a2,
+        std::type_identity_t<T> alpha = 1, std::type_identity_t<T> beta = 1, size_t numThreads = 1);
 
-    template<typename T, size_t M, size_t N> bool operator==(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs);
-    template<typename T, size_t M, size_t N> bool operator!=(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs);
+    template<typename T, size_t M, size_t N> constexpr bool operator==(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs);
+    template<typename T, size_t M, size_t N> constexpr bool operator!=(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs);
 
     // a diagonal matrix is an identity matrix multiply with a scalar value
-    template<typename T, size_t M, size_t N> Matrix<T,M,N> DiagonalMatrix(T v);
-    template<typename T, size_t M, size_t N> bool IsDiagonalMatrix(const Matrix<T,M,N>& a);
-    template<typename T, size_t M, size_t N> Matrix<T,M,N> IdentityMatrix();
-    template<typename T, size_t M, size_t N> Matrix<T,N,M> Transpose(const Matrix<T,M,N>& a);
+    template<typename T, size_t M, size_t N> constexpr Matrix<T,M,N> DiagonalMatrix(T v);
+    template<typename T, size_t M, size_t N> constexpr bool IsDiagonalMatrix(const Matrix<T,M,N>& a);
+    template<typename T, size_t M, size_t N> constexpr Matrix<T,M,N> IdentityMatrix();
+    // Cache blocked from detail::TransposeBlockedThreshold elements
+    template<typename T, size_t M, size_t N> constexpr Matrix<T,N,M> Transpose(const Matrix<T,M,N>& a);
+    // a = a^T without a second matrix
+    template<typename T, size_t N> constexpr Matrix<T,N,N>& TransposeInPlace(Matrix<T,N,N>& a);
     
-    template<typename T, size_t M, size_t N> Matrix<T,M-1,N-1> Submatrix(const Matrix<T,M,N>& a, int rowToRemove, int columnToRemove);
-    template<typename T, size_t M> T Determinant(const Matrix<T,M,M>& a);
+    template<typename T, size_t M, size_t N> constexpr Matrix<T,M-1,N-1> Submatrix(const Matrix<T,M,N>& a, int rowToRemove, int columnToRemove);
+    // Closed form up to 4x4, LU decomposition (floating point) or Bareiss elimination (integers) above
+    template<typename T, size_t M> constexpr T Determinant(const Matrix<T,M,M>& a);
 
+    /*
+    Inverts a in place (floating point only, a must not be singular).
+    Closed form up to 4x4, LU decomposition above. The batched overload inverts `count` matrices in
+    one call; up to 4x4 it runs the closed form over several matrices at once so the compiler can
+    vectorise across them, and splits large batches across numThreads threads (0 for every hardware thread).
+    MatrixPack.h has the other batched operations.
+    */
     template<typename T, size_t N> Matrix<T, N, N>& InverseMatrix(Matrix<T, N, N>& a);
+    template<typename T, size_t N> void InverseMatrix(Matrix<T, N, N>* a, size_t count, size_t numThreads = 1);
 
     /*
     a + B = | a 0 |
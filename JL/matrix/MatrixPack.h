@@ -0,0 +1,68 @@
+/*
+MatrixPack.h
+
+Structure of arrays (SoA) layout for many small square matrices: element k of L matrices is stored
+side by side, so an operation written for one matrix runs on L of them at once, one matrix per lane.
+
+    Matrix<T,4,4>[L]        m0(0,0) m0(0,1) ... m0(3,3) | m1(0,0) m1(0,1) ... m1(3,3) | ...
+    MatrixPack<T,4,L>       m0(0,0) m1(0,0) ... mL-1(0,0) | m0(0,1) m1(0,1) ... mL-1(0,1) | ...
+
+With L = 8, an element of a pack of floats fills an AVX register (16 for AVX-512). The pack operations are
+the closed forms of Matrix.inl with every scalar replaced by L lanes, which the compiler vectorises.
+
+Converting between arrays of matrices and packs moves every element twice, which costs more than a multiply
+or a determinant saves: keep data that is operated on many times in packs. The batch functions on arrays of
+matrices run the unrolled kernel of one matrix at a time instead, and split batches across numThreads threads
+(0 for every hardware thread) when they are large enough. The batched InverseMatrix in Matrix.h does pack,
+inversion is expensive enough to pay for it.
+*/
+
+#pragma once
+
+#include "JL/matrix/Matrix.h"
+#include "JL/utils/AlignedAllocator.h"
+
+#include <array>
+
+namespace jl
+{
+    template<typename T, size_t N, size_t L = 8>
+    struct MatrixPack
+    {
+        using Lane = detail::Lanes<T,L>;
+
+        // Elements[k].v[l] is element k (row-major) of matrix l
+        alignas(CacheLineSize) std::array<Lane, N*N> Elements;
+
+        MatrixPack() = default;
+        // Packs matrices[0, L)
+        explicit MatrixPack(const Matrix<T,N,N>* matrices);
+
+        static constexpr size_t size() { return L; }
+
+        // Gathers / scatters a single matrix
+        Matrix<T,N,N> operator[](size_t l) const;
+        void Set(size_t l, const Matrix<T,N,N>& a);
+
+        // out[0, L)
+        void ToMatrices(Matrix<T,N,N>* out) const;
+    };
+
+    // Lane by lane a[l] * b[l], a[l]^T, Determinant(a[l]) and the in place inverse (2x2, 3x3 and 4x4, floating point)
+    template<typename T, size_t N, size_t L> MatrixPack<T,N,L> operator*(const MatrixPack<T,N,L>& a, const MatrixPack<T,N,L>& b);
+    template<typename T, size_t N, size_t L> MatrixPack<T,N,L> Transpose(const MatrixPack<T,N,L>& a);
+    template<typename T, size_t N, size_t L> std::array<T,L> Determinant(const MatrixPack<T,N,L>& a);
+    template<typename T, size_t N, size_t L> MatrixPack<T,N,L>& InverseMatrix(MatrixPack<T,N,L>& a);
+
+    //////////////////////////// Batches
+
+    // out[i] = a[i] * b[i] for `count` matrices, out may be a or b
+    template<typename T, size_t N> void Multiply(const Matrix<T,N,N>* a, const Matrix<T,N,N>* b, Matrix<T,N,N>* out, size_t count, size_t numThreads = 1);
+    // out[i] = a[i]^T, out may be a
+    template<typename T, size_t N> void Transpose(const Matrix<T,N,N>* a, Matrix<T,N,N>* out, size_t count, size_t numThreads = 1);
+    // out[i] = Determinant(a[i]), 2x2, 3x3 and 4x4
+    template<typename T, size_t N> void Determinant(const Matrix<T,N,N>* a, T* out, size_t count, size_t numThreads = 1);
+
+}
+
+#include "detail/MatrixPack.inl"
@@ -5,6 +5,7 @@ RandomMatrix.h
 #pragma once
 
 #include "Matrix.h"
+#include "DynamicMatrix.h"
 
 #include "JL/geometry/Random.h"
 
@@ -21,4 +22,15 @@ namespace jl
         return a;
     }
 
+    template<typename T, typename RandomEng>
+    DynamicMatrix<T> RandomDynamicMatrix(RandomEng& e, size_t rows, size_t columns, T min, T max)
+    {
+        ASSERT(min <= max);
+        uniform_dist<T> rng(min, max);
+        DynamicMatrix<T> a(rows, columns);
+        for (size_t i = 0; i < a.size(); ++i)
+            a[i] = rng(e);
+        return a;
+    }
+
 } // namespace jl
\ No newline at end of file
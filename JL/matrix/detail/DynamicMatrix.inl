@@ -0,0 +1,330 @@
+/*
+DynamicMatrix.inl
+*/
+
+#pragma once
+
+#include "JL/utils/Utils.h"
+#include "JL/utils/Simd.h"
+#include "JL/matrix/Gemm.h"
+#include "JL/matrix/LUDecomposition.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace jl
+{
+    template<typename T>
+    DynamicMatrix<T>::DynamicMatrix(size_t rows, size_t columns)
+        : Elements(rows * columns), Rows(rows), Columns(columns)
+    {}
+
+    template<typename T>
+    DynamicMatrix<T>::DynamicMatrix(size_t rows, size_t columns, std::initializer_list<T> values)
+        : Elements(values), Rows(rows), Columns(columns)
+    {
+        ALWAYS_ASSERT(values.size() == rows * columns);
+    }
+
+    template<typename T>
+    template<size_t M, size_t N>
+    DynamicMatrix<T>::DynamicMatrix(const Matrix<T,M,N>& a)
+        : Elements(a.Elements.begin(), a.Elements.end()), Rows(M), Columns(N)
+    {}
+
+    template<typename T>
+    DynamicMatrix<T> DynamicMatrix<T>::Clone() const
+    {
+        DynamicMatrix<T> a;
+        a.Elements = Elements;
+        a.Rows = Rows;
+        a.Columns = Columns;
+        return a;
+    }
+
+    template<typename T>
+    template<size_t M, size_t N>
+    Matrix<T,M,N> DynamicMatrix<T>::ToMatrix() const
+    {
+        ALWAYS_ASSERT(Rows == M && Columns == N);
+        Matrix<T,M,N> a;
+        std::copy(Elements.begin(), Elements.end(), a.Elements.begin());
+        return a;
+    }
+
+    template<typename T>
+    std::ostream& operator<<(std::ostream& os, const DynamicMatrix<T>& a)
+    {
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            os << a[i] << " ";
+            if ((i+1) % a.Columns == 0) os << "\n";
+        }
+        return os;
+    }
+
+    // The vector kernels are always worth it here, the result allocation already costs more than the dispatch
+
+    template<typename T>
+    DynamicMatrix<T> operator+(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs)
+    {
+        ALWAYS_ASSERT(lhs.Rows == rhs.Rows && lhs.Columns == rhs.Columns);
+        DynamicMatrix<T> a(lhs.Rows, lhs.Columns);
+        if constexpr (simd::IsSupported<T>)
+            simd::Add(lhs.data(), rhs.data(), a.data(), a.size());
+        else
+            for (size_t i = 0; i < a.size(); ++i)
+                a[i] = lhs[i] + rhs[i];
+        return a;
+    }
+
+    template<typename T>
+    DynamicMatrix<T> operator-(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs)
+    {
+        ALWAYS_ASSERT(lhs.Rows == rhs.Rows && lhs.Columns == rhs.Columns);
+        DynamicMatrix<T> a(lhs.Rows, lhs.Columns);
+        if constexpr (simd::IsSupported<T>)
+            simd::Subtract(lhs.data(), rhs.data(), a.data(), a.size());
+        else
+            for (size_t i = 0; i < a.size(); ++i)
+                a[i] = lhs[i] - rhs[i];
+        return a;
+    }
+
+    template<typename T>
+    DynamicMatrix<T> operator*(const DynamicMatrix<T>& lhs, T s)
+    {
+        DynamicMatrix<T> a(lhs.Rows, lhs.Columns);
+        if constexpr (simd::IsSupported<T>)
+            simd::Scale(lhs.data(), s, a.data(), a.size());
+        else
+            for (size_t i = 0; i < a.size(); ++i)
+                a[i] = lhs[i] * s;
+        return a;
+    }
+
+    template<typename T>
+    DynamicMatrix<T> operator*(T s, const DynamicMatrix<T>& rhs)
+    {
+        return rhs * s;
+    }
+
+    template<typename T>
+    DynamicMatrix<T> operator/(const DynamicMatrix<T>& lhs, T s)
+    {
+        ASSERT(s != 0);
+        DynamicMatrix<T> a(lhs.Rows, lhs.Columns);
+        if constexpr (simd::IsSupported<T>)
+            simd::Divide(lhs.data(), s, a.data(), a.size());
+        else
+            for (size_t i = 0; i < a.size(); ++i)
+                a[i] = lhs[i] / s;
+        return a;
+    }
+
+    template<typename T>
+    DynamicMatrix<T>& operator+=(DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs)
+    {
+        ALWAYS_ASSERT(lhs.Rows == rhs.Rows && lhs.Columns == rhs.Columns);
+        if constexpr (simd::IsSupported<T>)
+            simd::Add(lhs.data(), rhs.data(), lhs.data(), lhs.size());
+        else
+            for (size_t i = 0; i < lhs.size(); ++i)
+                lhs[i] += rhs[i];
+        return lhs;
+    }
+
+    template<typename T>
+    DynamicMatrix<T>& operator-=(DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs)
+    {
+        ALWAYS_ASSERT(lhs.Rows == rhs.Rows && lhs.Columns == rhs.Columns);
+        if constexpr (simd::IsSupported<T>)
+            simd::Subtract(lhs.data(), rhs.data(), lhs.data(), lhs.size());
+        else
+            for (size_t i = 0; i < lhs.size(); ++i)
+                lhs[i] -= rhs[i];
+        return lhs;
+    }
+
+    template<typename T>
+    DynamicMatrix<T>& operator*=(DynamicMatrix<T>& lhs, T s)
+    {
+        if constexpr (simd::IsSupported<T>)
+            simd::Scale(lhs.data(), s, lhs.data(), lhs.size());
+        else
+            for (size_t i = 0; i < lhs.size(); ++i)
+                lhs[i] *= s;
+        return lhs;
+    }
+
+    template<typename T>
+    DynamicMatrix<T>& operator/=(DynamicMatrix<T>& lhs, T s)
+    {
+        ASSERT(s != 0);
+        if constexpr (simd::IsSupported<T>)
+            simd::Divide(lhs.data(), s, lhs.data(), lhs.size());
+        else
+            for (size_t i = 0; i < lhs.size(); ++i)
+                lhs[i] /= s;
+        return lhs;
+    }
+
+    template<typename T>
+    DynamicMatrix<T> operator*(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs)
+    {
+        ALWAYS_ASSERT(lhs.Columns == rhs.Rows);
+        DynamicMatrix<T> a(lhs.Rows, rhs.Columns);
+        detail::Gemm(lhs.Rows, lhs.Columns, rhs.Columns, lhs.data(), lhs.Columns, rhs.data(), rhs.Columns, a.data(), a.Columns);
+        return a;
+    }
+
+    template<typename T>
+    DynamicMatrix<T> ParallelMultiply(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs, size_t numThreads)
+    {
+        ALWAYS_ASSERT(lhs.Columns == rhs.Rows);
+        DynamicMatrix<T> a(lhs.Rows, rhs.Columns);
+        detail::GemmParallel(lhs.Rows, lhs.Columns, rhs.Columns, lhs.data(), lhs.Columns, rhs.data(), rhs.Columns, a.data(), a.Columns, numThreads);
+        return a;
+    }
+
+    template<typename T>
+    void MultiplyAdd(DynamicMatrix<T>& c, const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs, std::type_identity_t<T> alpha, std::type_identity_t<T> beta, size_t numThreads)
+    {
+        ALWAYS_ASSERT(lhs.Columns == rhs.Rows && c.Rows == lhs.Rows && c.Columns == rhs.Columns);
+        ASSERT(&c != &lhs && &c != &rhs);
+        detail::GemmParallel(lhs.Rows, lhs.Columns, rhs.Columns, alpha, lhs.data(), lhs.Columns, rhs.data(), rhs.Columns, beta, c.data(), c.Columns, numThreads);
+    }
+
+    template<typename T, size_t M, size_t N>
+    DynamicMatrix<T> operator*(const Matrix<T,M,N>& lhs, const DynamicMatrix<T>& rhs)
+    {
+        ALWAYS_ASSERT(N == rhs.Rows);
+        DynamicMatrix<T> a(M, rhs.Columns);
+        detail::Gemm(M, N, rhs.Columns, lhs.Elements.data(), N, rhs.data(), rhs.Columns, a.data(), a.Columns);
+        return a;
+    }
+
+    template<typename T, size_t M, size_t N>
+    DynamicMatrix<T> operator*(const DynamicMatrix<T>& lhs, const Matrix<T,M,N>& rhs)
+    {
+        ALWAYS_ASSERT(lhs.Columns == M);
+        DynamicMatrix<T> a(lhs.Rows, N);
+        detail::Gemm(lhs.Rows, M, N, lhs.data(), M, rhs.Elements.data(), N, a.data(), N);
+        return a;
+    }
+
+    template<typename T>
+    bool operator==(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs)
+    {
+        return lhs.Rows == rhs.Rows && lhs.Columns == rhs.Columns && lhs.Elements == rhs.Elements;
+    }
+
+    template<typename T>
+    bool operator!=(const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<typename T>
+    DynamicMatrix<T> Transpose(const DynamicMatrix<T>& a)
+    {
+        DynamicMatrix<T> t(a.Columns, a.Rows);
+        detail::TransposeBlocked(a.Rows, a.Columns, a.data(), a.Columns, t.data(), t.Columns);
+        return t;
+    }
+
+    template<typename T>
+    DynamicMatrix<T>& TransposeInPlace(DynamicMatrix<T>& a)
+    {
+        ALWAYS_ASSERT(a.Rows == a.Columns);
+        detail::TransposeSquareInPlace(a.Rows, a.data(), a.Columns);
+        return a;
+    }
+
+    template<typename T>
+    TransposedView<DynamicMatrix<T>> Transposed(const DynamicMatrix<T>& a)
+    {
+        return { a };
+    }
+
+    template<typename T>
+    DynamicMatrix<T> operator*(TransposedView<DynamicMatrix<T>> lhs, const DynamicMatrix<T>& rhs)
+    {
+        // lhs^T is Columns x Rows, read through swapped strides
+        const DynamicMatrix<T>& s = lhs.Source;
+        ALWAYS_ASSERT(s.Rows == rhs.Rows);
+        DynamicMatrix<T> a(s.Columns, rhs.Columns);
+        if (a.size() * s.Rows >= detail::GemmBlockedThreshold)
+            detail::GemmBlocked(s.Columns, s.Rows, rhs.Columns, T(1), s.data(), size_t(1), s.Columns, rhs.data(), rhs.Columns, size_t(1), T(0), a.data(), a.Columns);
+        else
+            detail::GemmNaive(s.Columns, s.Rows, rhs.Columns, T(1), s.data(), size_t(1), s.Columns, rhs.data(), rhs.Columns, size_t(1), T(0), a.data(), a.Columns);
+        return a;
+    }
+
+    template<typename T>
+    DynamicMatrix<T> operator*(const DynamicMatrix<T>& lhs, TransposedView<DynamicMatrix<T>> rhs)
+    {
+        const DynamicMatrix<T>& s = rhs.Source;
+        ALWAYS_ASSERT(lhs.Columns == s.Columns);
+        DynamicMatrix<T> a(lhs.Rows, s.Rows);
+        if (a.size() * lhs.Columns >= detail::GemmBlockedThreshold)
+            detail::GemmBlocked(lhs.Rows, lhs.Columns, s.Rows, T(1), lhs.data(), lhs.Columns, size_t(1), s.data(), size_t(1), s.Columns, T(0), a.data(), a.Columns);
+        else
+            detail::GemmNaive(lhs.Rows, lhs.Columns, s.Rows, T(1), lhs.data(), lhs.Columns, size_t(1), s.data(), size_t(1), s.Columns, T(0), a.data(), a.Columns);
+        return a;
+    }
+
+    template<typename T>
+    T Determinant(const DynamicMatrix<T>& a)
+    {
+        ALWAYS_ASSERT(a.Rows == a.Columns);
+        const size_t n = a.Rows;
+
+        switch (n)
+        {
+        case 0: return T(1);
+        case 1: return a[0];
+        case 2: return Determinant(a.template ToMatrix<2,2>());
+        case 3: return Determinant(a.template ToMatrix<3,3>());
+        case 4: return Determinant(a.template ToMatrix<4,4>());
+        }
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            typename DynamicMatrix<T>::Storage lu = a.Elements;
+            std::vector<size_t> pivots(n);
+            const int sign = detail::LUFactor(lu.data(), n, pivots.data());
+            return sign == 0 ? T(0) : detail::LUDeterminant(lu.data(), n, sign);
+        }
+        else
+        {
+            return detail::BareissDeterminant(a.data(), n);
+        }
+    }
+
+    template<typename T>
+    DynamicMatrix<T>& InverseMatrix(DynamicMatrix<T>& a)
+    {
+        static_assert(std::is_floating_point_v<T>, "InverseMatrix requires a floating point type");
+        ALWAYS_ASSERT(a.Rows == a.Columns);
+        const size_t n = a.Rows;
+
+        switch (n)
+        {
+        case 0: break;
+        case 1: ASSERT(a[0] != T(0)); a[0] = T(1) / a[0]; break;
+        case 2: detail::InverseClosedForm<2>(a.data(), a.data()); break;
+        case 3: detail::InverseClosedForm<3>(a.data(), a.data()); break;
+        case 4: detail::InverseClosedForm<4>(a.data(), a.data()); break;
+        default:
+            {
+                typename DynamicMatrix<T>::Storage lu = a.Elements;
+                std::vector<size_t> pivots(n);
+                VERIFY(detail::LUFactor(lu.data(), n, pivots.data()) != 0);
+                detail::LUInverse(lu.data(), n, pivots.data(), a.data());
+            }
+        }
+        return a;
+    }
+
+}
@@ -0,0 +1,369 @@
+/*
+Gemm.inl
+*/
+
+#pragma once
+
+#include "JL/utils/ThreadPool.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define JL_GEMM_SSE2 1
+    #include <immintrin.h>
+#else
+    #define JL_GEMM_SSE2 0
+#endif
+
+namespace jl
+{
+    namespace detail
+    {
+        // f(std::integral_constant<size_t, I>()) for I = 0, 1, ..., Count-1, unrolled at compile time
+        template<size_t Count, typename F>
+        void Unroll(F&& f)
+        {
+            [&]<size_t... I>(std::index_sequence<I...>) { (f(std::integral_constant<size_t, I>()), ...); }(std::make_index_sequence<Count>());
+        }
+
+        template<typename T, size_t M, size_t N, size_t P>
+        inline void GemmSmall(const T* a, const T* b, T* c)
+        {
+            static_assert(0 < N && M <= GemmSmallMax && N <= GemmSmallMax && P <= GemmSmallMax, "GemmSmall is for sizes up to 4");
+
+#if JL_GEMM_SSE2
+            if constexpr (std::is_same_v<T, float> && P == 4)
+            {
+                __m128 rows[N];
+                Unroll<N>([&](auto n) { rows[n] = _mm_loadu_ps(b + n*4); });
+                Unroll<M>([&](auto m)
+                {
+                    __m128 r = _mm_mul_ps(_mm_set1_ps(a[m*N]), rows[0]);
+                    Unroll<N-1>([&](auto n) { r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[m*N+n+1]), rows[n+1])); });
+                    _mm_storeu_ps(c + m*4, r);
+                });
+                return;
+            }
+            else if constexpr (std::is_same_v<T, double> && P == 4)
+            {
+    #if defined(__AVX__)
+                __m256d rows[N];
+                Unroll<N>([&](auto n) { rows[n] = _mm256_loadu_pd(b + n*4); });
+                Unroll<M>([&](auto m)
+                {
+                    __m256d r = _mm256_mul_pd(_mm256_set1_pd(a[m*N]), rows[0]);
+                    Unroll<N-1>([&](auto n) { r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(a[m*N+n+1]), rows[n+1])); });
+                    _mm256_storeu_pd(c + m*4, r);
+                });
+    #else
+                // two halves of a row per register
+                __m128d lo[N], hi[N];
+                Unroll<N>([&](auto n) { lo[n] = _mm_loadu_pd(b + n*4); hi[n] = _mm_loadu_pd(b + n*4 + 2); });
+                Unroll<M>([&](auto m)
+                {
+                    __m128d s = _mm_set1_pd(a[m*N]);
+                    __m128d rl = _mm_mul_pd(s, lo[0]);
+                    __m128d rh = _mm_mul_pd(s, hi[0]);
+                    Unroll<N-1>([&](auto n)
+                    {
+                        s = _mm_set1_pd(a[m*N+n+1]);
+                        rl = _mm_add_pd(rl, _mm_mul_pd(s, lo[n+1]));
+                        rh = _mm_add_pd(rh, _mm_mul_pd(s, hi[n+1]));
+                    });
+                    _mm_storeu_pd(c + m*4, rl);
+                    _mm_storeu_pd(c + m*4 + 2, rh);
+                });
+    #endif
+                return;
+            }
+#endif
+            // the same order of accumulation as GemmNaive
+            Unroll<M>([&](auto m)
+            {
+                Unroll<P>([&](auto p)
+                {
+                    T sum = a[m*N] * b[p];
+                    Unroll<N-1>([&](auto n) { sum += a[m*N+n+1] * b[(n+1)*P+p]; });
+                    c[m*P+p] = sum;
+                });
+            });
+        }
+
+        template<typename T>
+        constexpr void GemmNaive(size_t M, size_t N, size_t P, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc)
+        {
+            for (size_t m = 0; m < M; ++m)
+                for (size_t p = 0; p < P; ++p)
+                {
+                    T sum = 0;
+                    for (size_t n = 0; n < N; ++n)
+                        sum += a[m*lda+n] * b[n*ldb+p];
+                    c[m*ldc+p] = sum;
+                }
+        }
+
+        template<typename T>
+        constexpr void GemmNaive(size_t M, size_t N, size_t P, T alpha, const T* a, size_t lda, const T* b, size_t ldb, T beta, T* c, size_t ldc)
+        {
+            for (size_t m = 0; m < M; ++m)
+                for (size_t p = 0; p < P; ++p)
+                {
+                    T sum = 0;
+                    for (size_t n = 0; n < N; ++n)
+                        sum += a[m*lda+n] * b[n*ldb+p];
+                    c[m*ldc+p] = beta == T(0) ? alpha * sum : alpha * sum + beta * c[m*ldc+p];
+                }
+        }
+
+        template<typename T>
+        constexpr void GemmNaive(size_t M, size_t N, size_t P, T alpha, const T* a, size_t rsa, size_t csa, const T* b, size_t rsb, size_t csb, T beta, T* c, size_t ldc)
+        {
+            for (size_t m = 0; m < M; ++m)
+                for (size_t p = 0; p < P; ++p)
+                {
+                    T sum = 0;
+                    for (size_t n = 0; n < N; ++n)
+                        sum += a[m*rsa + n*csa] * b[n*rsb + p*csb];
+                    c[m*ldc+p] = beta == T(0) ? alpha * sum : alpha * sum + beta * c[m*ldc+p];
+                }
+        }
+
+        template<typename T>
+        constexpr void Gemv(size_t M, size_t N, T alpha, const T* a, size_t lda, const T* x, T beta, T* y)
+        {
+            GemmNaive(M, N, size_t(1), alpha, a, lda, x, size_t(1), beta, y, size_t(1));
+        }
+
+        // Copies the mc x kc block of a into MR tall strips, each strip stored k-major so the
+        // micro-kernel reads MR consecutive values per step. Rows past mc are zero padded.
+        // Element (i, k) of a is a[i*rsa + k*csa], so a transposed a is packed by swapping the strides.
+        template<typename T>
+        void GemmPackA(size_t mc, size_t kc, const T* a, size_t rsa, size_t csa, T* packed)
+        {
+            constexpr size_t MR = GemmBlocking<T>::MR;
+            for (size_t ir = 0; ir < mc; ir += MR)
+            {
+                const size_t mr = std::min(MR, mc - ir);
+                for (size_t k = 0; k < kc; ++k)
+                {
+                    for (size_t i = 0; i < mr; ++i) packed[i] = a[(ir+i)*rsa + k*csa];
+                    for (size_t i = mr; i < MR; ++i) packed[i] = T(0);
+                    packed += MR;
+                }
+            }
+        }
+
+        // Copies the kc x nc panel of b into NR wide strips, each strip stored k-major.
+        // Columns past nc are zero padded. Element (k, j) of b is b[k*rsb + j*csb].
+        template<typename T>
+        void GemmPackB(size_t kc, size_t nc, const T* b, size_t rsb, size_t csb, T* packed)
+        {
+            constexpr size_t NR = GemmBlocking<T>::NR;
+            for (size_t jr = 0; jr < nc; jr += NR)
+            {
+                const size_t nr = std::min(NR, nc - jr);
+                for (size_t k = 0; k < kc; ++k)
+                {
+                    const T* row = b + k*rsb + jr*csb;
+                    if (csb == 1)
+                        for (size_t j = 0; j < nr; ++j) packed[j] = row[j];
+                    else
+                        for (size_t j = 0; j < nr; ++j) packed[j] = row[j*csb];
+                    for (size_t j = nr; j < NR; ++j) packed[j] = T(0);
+                    packed += NR;
+                }
+            }
+        }
+
+        // c(mr x nr) = alpha * a(MR x kc) * b(kc x NR) + beta * c
+        // The MR x NR accumulator is small enough to stay in registers, the j loop is the one that vectorises.
+        // It starts from zero and c is added last, as in GemmNaive. With resume, c holds the sums of the earlier
+        // KC panels of a plain product (alpha 1, beta 0) and the accumulator continues from them.
+        template<typename T>
+        void GemmMicroKernel(size_t kc, const T* ap, const T* bp, T* c, size_t ldc, size_t mr, size_t nr, T alpha, T beta, bool resume)
+        {
+            constexpr size_t MR = GemmBlocking<T>::MR;
+            constexpr size_t NR = GemmBlocking<T>::NR;
+
+            T acc[MR][NR];
+            for (size_t i = 0; i < MR; ++i)
+                for (size_t j = 0; j < NR; ++j)
+                    acc[i][j] = (resume && i < mr && j < nr) ? c[i*ldc+j] : T(0);
+
+            for (size_t k = 0; k < kc; ++k)
+            {
+                for (size_t i = 0; i < MR; ++i)
+                {
+                    const T ai = ap[i];
+                    for (size_t j = 0; j < NR; ++j)
+                        acc[i][j] += ai * bp[j];
+                }
+                ap += MR;
+                bp += NR;
+            }
+
+            if (resume || (alpha == T(1) && beta == T(0)))
+            {
+                for (size_t i = 0; i < mr; ++i)
+                    for (size_t j = 0; j < nr; ++j)
+                        c[i*ldc+j] = acc[i][j];
+            }
+            else if (beta == T(0))
+            {
+                for (size_t i = 0; i < mr; ++i)
+                    for (size_t j = 0; j < nr; ++j)
+                        c[i*ldc+j] = alpha * acc[i][j];
+            }
+            else
+            {
+                for (size_t i = 0; i < mr; ++i)
+                    for (size_t j = 0; j < nr; ++j)
+                        c[i*ldc+j] = alpha * acc[i][j] + beta * c[i*ldc+j];
+            }
+        }
+
+        template<typename T>
+        void GemmBlocked(size_t M, size_t N, size_t P, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc)
+        {
+            GemmBlocked(M, N, P, T(1), a, lda, b, ldb, T(0), c, ldc);
+        }
+
+        template<typename T>
+        void GemmBlocked(size_t M, size_t N, size_t P, T alpha, const T* a, size_t lda, const T* b, size_t ldb, T beta, T* c, size_t ldc)
+        {
+            GemmBlocked(M, N, P, alpha, a, lda, size_t(1), b, ldb, size_t(1), beta, c, ldc);
+        }
+
+        template<typename T>
+        void GemmBlocked(size_t M, size_t N, size_t P, T alpha, const T* a, size_t rsa, size_t csa, const T* b, size_t rsb, size_t csb, T beta, T* c, size_t ldc)
+        {
+            using Blocking = GemmBlocking<T>;
+            constexpr size_t MR = Blocking::MR, NR = Blocking::NR;
+            constexpr size_t MC = Blocking::MC, KC = Blocking::KC, NC = Blocking::NC;
+
+            if (N == 0)
+            {
+                for (size_t m = 0; m < M; ++m)
+                    for (size_t p = 0; p < P; ++p)
+                        c[m*ldc+p] = beta == T(0) ? T(0) : beta * c[m*ldc+p];
+                return;
+            }
+
+            // Packing buffers are reused across calls on the same thread
+            thread_local std::vector<T> packedA;
+            thread_local std::vector<T> packedB;
+            packedA.resize(((MC + MR - 1) / MR) * MR * KC);
+            packedB.resize(((NC + NR - 1) / NR) * NR * KC);
+            const bool plain = alpha == T(1) && beta == T(0);
+
+            for (size_t jc = 0; jc < P; jc += NC)
+            {
+                const size_t nc = std::min(NC, P - jc);
+                for (size_t pc = 0; pc < N; pc += KC)
+                {
+                    const size_t kc = std::min(KC, N - pc);
+                    GemmPackB(kc, nc, b + pc*rsb + jc*csb, rsb, csb, packedB.data());
+
+                    for (size_t ic = 0; ic < M; ic += MC)
+                    {
+                        const size_t mc = std::min(MC, M - ic);
+                        GemmPackA(mc, kc, a + ic*rsa + pc*csa, rsa, csa, packedA.data());
+
+                        for (size_t jr = 0; jr < nc; jr += NR)
+                        {
+                            const T* bp = packedB.data() + jr*kc;
+                            for (size_t ir = 0; ir < mc; ir += MR)
+                            {
+                                const T* ap = packedA.data() + ir*kc;
+                                // later panels continue the sums of a plain product, or add alpha times theirs to c
+                                GemmMicroKernel(kc, ap, bp, c + (ic+ir)*ldc + jc+jr, ldc,
+                                    std::min(MR, mc - ir), std::min(NR, nc - jr), alpha, pc > 0 ? T(1) : beta, pc > 0 && plain);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        template<typename T>
+        void Gemm(size_t M, size_t N, size_t P, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc)
+        {
+            if (M*N*P >= GemmBlockedThreshold)
+                GemmBlocked(M, N, P, a, lda, b, ldb, c, ldc);
+            else
+                GemmNaive(M, N, P, a, lda, b, ldb, c, ldc);
+        }
+
+        template<typename T>
+        void Gemm(size_t M, size_t N, size_t P, T alpha, const T* a, size_t lda, const T* b, size_t ldb, T beta, T* c, size_t ldc)
+        {
+            if (P == 1 && ldb == 1 && ldc == 1)
+                Gemv(M, N, alpha, a, lda, b, beta, c);
+            else if (M*N*P >= GemmBlockedThreshold)
+                GemmBlocked(M, N, P, alpha, a, lda, b, ldb, beta, c, ldc);
+            else
+                GemmNaive(M, N, P, alpha, a, lda, b, ldb, beta, c, ldc);
+        }
+
+        template<typename T>
+        void GemmParallel(size_t M, size_t N, size_t P, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc, size_t numThreads)
+        {
+            GemmParallel(M, N, P, T(1), a, lda, b, ldb, T(0), c, ldc, numThreads);
+        }
+
+        template<typename T>
+        void GemmParallel(size_t M, size_t N, size_t P, T alpha, const T* a, size_t lda, const T* b, size_t ldb, T beta, T* c, size_t ldc, size_t numThreads)
+        {
+            if (numThreads == 1 || M*N*P < GemmParallelThreshold)
+            {
+                Gemm(M, N, P, alpha, a, lda, b, ldb, beta, c, ldc);
+                return;
+            }
+
+            // tiles are numbered row by row, so the contiguous run of tiles a thread starts with shares rows of a
+            const size_t tileRows = (M + GemmTileRows - 1) / GemmTileRows;
+            const size_t tileColumns = (P + GemmTileColumns - 1) / GemmTileColumns;
+            ThreadPool::Shared().Run(tileRows * tileColumns, numThreads, [&](size_t tile)
+            {
+                const size_t i = tile / tileColumns * GemmTileRows;
+                const size_t j = tile % tileColumns * GemmTileColumns;
+                GemmBlocked(std::min(GemmTileRows, M - i), N, std::min(GemmTileColumns, P - j),
+                    alpha, a + i*lda, lda, b + j, ldb, beta, c + i*ldc + j, ldc);
+            });
+        }
+
+        template<typename T>
+        constexpr void TransposeBlocked(size_t M, size_t N, const T* a, size_t lda, T* t, size_t ldt)
+        {
+            constexpr size_t B = TransposeBlockSize;
+            for (size_t ib = 0; ib < M; ib += B)
+                for (size_t jb = 0; jb < N; jb += B)
+                {
+                    const size_t iEnd = std::min(ib + B, M), jEnd = std::min(jb + B, N);
+                    for (size_t i = ib; i < iEnd; ++i)
+                        for (size_t j = jb; j < jEnd; ++j)
+                            t[j*ldt+i] = a[i*lda+j];
+                }
+        }
+
+        template<typename T>
+        constexpr void TransposeSquareInPlace(size_t N, T* a, size_t lda)
+        {
+            // the blocks on and above the diagonal, each swapped with its mirror below
+            constexpr size_t B = TransposeBlockSize;
+            for (size_t ib = 0; ib < N; ib += B)
+                for (size_t jb = ib; jb < N; jb += B)
+                {
+                    const size_t iEnd = std::min(ib + B, N), jEnd = std::min(jb + B, N);
+                    for (size_t i = ib; i < iEnd; ++i)
+                        for (size_t j = std::max(jb, i + 1); j < jEnd; ++j)
+                            std::swap(a[i*lda+j], a[j*lda+i]);
+                }
+        }
+
+    } // namespace detail
+
+} // namespace jl
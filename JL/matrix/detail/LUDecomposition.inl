@@ -0,0 +1,195 @@
+/*
+LUDecomposition.inl
+*/
+
+#pragma once
+
+#include "JL/utils/Utils.h"
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jl
+{
+    namespace detail
+    {
+        template<typename T>
+        int LUFactor(T* a, size_t n, size_t* pivots)
+        {
+            static_assert(std::is_floating_point_v<T>, "LU decomposition requires a floating point type");
+
+            int sign = 1;
+            bool singular = false;
+            for (size_t i = 0; i < n; ++i) pivots[i] = i;
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                // partial pivoting: bring the largest remaining entry of column k onto the diagonal
+                size_t p = k;
+                for (size_t i = k + 1; i < n; ++i)
+                    if (std::abs(a[i*n+k]) > std::abs(a[p*n+k])) p = i;
+
+                if (a[p*n+k] == T(0))
+                {
+                    singular = true;
+                    continue;
+                }
+
+                if (p != k)
+                {
+                    for (size_t j = 0; j < n; ++j) std::swap(a[k*n+j], a[p*n+j]);
+                    std::swap(pivots[k], pivots[p]);
+                    sign = -sign;
+                }
+
+                const T* rowK = a + k*n;
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    T* rowI = a + i*n;
+                    const T l = rowI[k] / rowK[k];
+                    rowI[k] = l;
+                    for (size_t j = k + 1; j < n; ++j)
+                        rowI[j] -= l * rowK[j];
+                }
+            }
+            return singular ? 0 : sign;
+        }
+
+        template<typename T>
+        T LUDeterminant(const T* lu, size_t n, int pivotSign)
+        {
+            T d = T(pivotSign);
+            for (size_t i = 0; i < n; ++i)
+                d *= lu[i*n+i];
+            return d;
+        }
+
+        template<typename T>
+        void LUSolve(const T* lu, size_t n, const size_t* pivots, const T* b, T* x)
+        {
+            // Ly = Pb
+            for (size_t i = 0; i < n; ++i)
+            {
+                T sum = b[pivots[i]];
+                for (size_t j = 0; j < i; ++j)
+                    sum -= lu[i*n+j] * x[j];
+                x[i] = sum;
+            }
+            // Ux = y
+            for (size_t i = n; i-- > 0;)
+            {
+                T sum = x[i];
+                for (size_t j = i + 1; j < n; ++j)
+                    sum -= lu[i*n+j] * x[j];
+                x[i] = sum / lu[i*n+i];
+            }
+        }
+
+        template<typename T>
+        void LUInverse(const T* lu, size_t n, const size_t* pivots, T* inverse)
+        {
+            // LY = P, row i of P is the unit row e(pivots[i])
+            for (size_t i = 0; i < n; ++i)
+            {
+                T* rowI = inverse + i*n;
+                for (size_t j = 0; j < n; ++j) rowI[j] = T(0);
+                rowI[pivots[i]] = T(1);
+                for (size_t k = 0; k < i; ++k)
+                {
+                    const T l = lu[i*n+k];
+                    const T* rowK = inverse + k*n;
+                    for (size_t j = 0; j < n; ++j)
+                        rowI[j] -= l * rowK[j];
+                }
+            }
+            // UX = Y
+            for (size_t i = n; i-- > 0;)
+            {
+                T* rowI = inverse + i*n;
+                for (size_t k = i + 1; k < n; ++k)
+                {
+                    const T u = lu[i*n+k];
+                    const T* rowK = inverse + k*n;
+                    for (size_t j = 0; j < n; ++j)
+                        rowI[j] -= u * rowK[j];
+                }
+                const T d = T(1) / lu[i*n+i];
+                for (size_t j = 0; j < n; ++j)
+                    rowI[j] *= d;
+            }
+        }
+
+        template<typename T>
+        T BareissDeterminant(const T* a, size_t n)
+        {
+            using W = std::conditional_t<std::is_integral_v<T>, int64_t, T>;
+            if (n == 0) return T(1);
+
+            std::vector<W> w(a, a + n*n);
+            W previous = 1;
+            int sign = 1;
+
+            for (size_t k = 0; k + 1 < n; ++k)
+            {
+                if (w[k*n+k] == W(0))
+                {
+                    size_t p = k + 1;
+                    while (p < n && w[p*n+k] == W(0)) ++p;
+                    if (p == n) return T(0);
+                    for (size_t j = 0; j < n; ++j) std::swap(w[k*n+j], w[p*n+j]);
+                    sign = -sign;
+                }
+
+                // every division here is exact (Sylvester's identity)
+                for (size_t i = k + 1; i < n; ++i)
+                    for (size_t j = k + 1; j < n; ++j)
+                        w[i*n+j] = (w[i*n+j] * w[k*n+k] - w[i*n+k] * w[k*n+j]) / previous;
+                previous = w[k*n+k];
+            }
+            return static_cast<T>(sign * w[(n-1)*n+(n-1)]);
+        }
+    } // namespace detail
+
+    template<typename T, size_t N>
+    LUDecomposition<T,N> LUDecompose(const Matrix<T,N,N>& a)
+    {
+        LUDecomposition<T,N> lu{ a, {}, 1, false };
+        lu.PivotSign = detail::LUFactor(lu.LU.Elements.data(), N, lu.Pivots.data());
+        lu.IsSingular = (lu.PivotSign == 0);
+        return lu;
+    }
+
+    template<typename T, size_t N>
+    T Determinant(const LUDecomposition<T,N>& lu)
+    {
+        if (lu.IsSingular) return T(0);
+        return detail::LUDeterminant(lu.LU.Elements.data(), N, lu.PivotSign);
+    }
+
+    template<typename T, size_t N>
+    Point<T,N> Solve(const LUDecomposition<T,N>& lu, const Point<T,N>& b)
+    {
+        ASSERT(!lu.IsSingular);
+        Point<T,N> x;
+        detail::LUSolve(lu.LU.Elements.data(), N, lu.Pivots.data(), b.data(), x.data());
+        return x;
+    }
+
+    template<typename T, size_t N>
+    Matrix<T,N,N> Inverse(const LUDecomposition<T,N>& lu)
+    {
+        ASSERT(!lu.IsSingular);
+        Matrix<T,N,N> inverse;
+        detail::LUInverse(lu.LU.Elements.data(), N, lu.Pivots.data(), inverse.Elements.data());
+        return inverse;
+    }
+
+    template<typename T, size_t N>
+    T DeterminantBareiss(const Matrix<T,N,N>& a)
+    {
+        return detail::BareissDeterminant(a.Elements.data(), N);
+    }
+}
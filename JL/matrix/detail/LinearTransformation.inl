@@ -0,0 +1,253 @@
+/*
+LinearTransformation.inl
+*/
+
+#pragma once
+
+#include "JL/utils/Utils.h"
+#include "JL/utils/Parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace jl
+{
+    namespace detail
+    {
+        // Points per block of the batched transforms, the D input and D output arrays of a block stay in L1
+        constexpr size_t TransformBlock = 256;
+
+        // out[r][i] = sum over c of a(r, c) * in[c][i], plus a(r, D) for an affine a, for n values of each array.
+        // The products are summed in the order of the single point Transform. out must not alias in.
+        template<typename T, size_t N, size_t D>
+        void TransformCoordinates(const Matrix<T,N,N>& a, const std::array<const T*, D>& in, const std::array<T*, D>& out, size_t n)
+        {
+            static_assert(N == D || N == D + 1, "a is a D x D or D+1 x D+1 matrix");
+            for (size_t r = 0; r < D; ++r)
+            {
+                CloudScale(in[0], a[r*N], out[r], n);
+                for (size_t c = 1; c < D; ++c)
+                    CloudScaleAdd(in[c], a[r*N+c], out[r], out[r], n);
+                if constexpr (N == D + 1)
+                    CloudAddScalar(out[r], a[r*N+D], out[r], n);
+            }
+        }
+
+        template<typename T, size_t N, size_t D>
+        constexpr Point<T,D> TransformPoint(const Matrix<T,N,N>& a, const Point<T,D>& p)
+        {
+            static_assert(N == D || N == D + 1, "a is a D x D or D+1 x D+1 matrix");
+            Point<T,D> result;
+            for (size_t r = 0; r < D; ++r)
+            {
+                T sum = a[r*N] * p[0];
+                for (size_t c = 1; c < D; ++c)
+                    sum = p[c] * a[r*N+c] + sum;
+                if constexpr (N == D + 1)
+                    sum = sum + a[r*N+D];
+                result[r] = sum;
+            }
+            return result;
+        }
+
+        template<typename T, size_t N, size_t D>
+        void TransformPoints(const Matrix<T,N,N>& a, const Point<T,D>* in, Point<T,D>* out, size_t count, size_t numThreads)
+        {
+            ParallelFor(count, numThreads, [&](size_t begin, size_t end)
+            {
+                // A local copy cannot alias out, so the elements stay in registers across the loop and the
+                // compiler vectorises it over the interleaved coordinates
+                const Matrix<T,N,N> m = a;
+                for (size_t i = begin; i < end; ++i) out[i] = TransformPoint(m, in[i]);
+            });
+        }
+    }
+
+    template<typename T, size_t D>
+    constexpr Matrix<T,D,D> ScaleMatrix(T factor)
+    {
+        Matrix<T,D,D> a;
+        for (size_t d = 0; d < D; ++d) a[d*D+d] = factor;
+        return a;
+    }
+
+    template<typename T, size_t D>
+    constexpr Matrix<T,D,D> ScaleMatrix(const Point<T,D>& factors)
+    {
+        Matrix<T,D,D> a;
+        for (size_t d = 0; d < D; ++d) a[d*D+d] = factors[d];
+        return a;
+    }
+
+    template<typename T>
+    Matrix<T,2,2> RotationMatrix(T angle)
+    {
+        return RotationMatrix(std::cos(angle), std::sin(angle));
+    }
+
+    template<typename T>
+    constexpr Matrix<T,2,2> RotationMatrix(T cosine, T sine)
+    {
+        return Matrix<T,2,2>(cosine, -sine,
+                             sine,   cosine);
+    }
+
+    template<typename T>
+    Matrix<T,3,3> RotationMatrix(const Point<T,3>& axis, T angle)
+    {
+        return RotationMatrix(axis, std::cos(angle), std::sin(angle));
+    }
+
+    template<typename T>
+    constexpr Matrix<T,3,3> RotationMatrix(const Point<T,3>& axis, T cosine, T sine)
+    {
+        // cos I + sin [axis]x + (1 - cos) axis axis^T
+        const T x = axis[0], y = axis[1], z = axis[2];
+        const T t = T(1) - cosine;
+        return Matrix<T,3,3>(t*x*x + cosine,   t*x*y - sine*z,   t*x*z + sine*y,
+                             t*x*y + sine*z,   t*y*y + cosine,   t*y*z - sine*x,
+                             t*x*z - sine*y,   t*y*z + sine*x,   t*z*z + cosine);
+    }
+
+    template<typename T, size_t D>
+    constexpr Matrix<T,D,D> ShearMatrix(size_t row, size_t column, T factor)
+    {
+        ASSERT(row < D && column < D && row != column);
+        auto a = ScaleMatrix<T,D>(T(1));
+        a[row*D+column] = factor;
+        return a;
+    }
+
+    template<typename T, size_t D>
+    constexpr Matrix<T,D,D> ReflectionMatrix(const Point<T,D>& normal)
+    {
+        Matrix<T,D,D> a;
+        for (size_t r = 0; r < D; ++r)
+            for (size_t c = 0; c < D; ++c)
+                a[r*D+c] = (r == c ? T(1) : T(0)) - T(2) * normal[r] * normal[c];
+        return a;
+    }
+
+    template<typename T, size_t D>
+    constexpr Matrix<T,D+1,D+1> TranslationMatrix(const Point<T,D>& offset)
+    {
+        return AffineMatrix(ScaleMatrix<T,D>(T(1)), offset);
+    }
+
+    template<typename T, size_t D>
+    constexpr Matrix<T,D+1,D+1> AffineMatrix(const Matrix<T,D,D>& linear, const Point<T,D>& offset)
+    {
+        constexpr size_t N = D + 1;
+        Matrix<T,N,N> a;
+        for (size_t r = 0; r < D; ++r)
+        {
+            for (size_t c = 0; c < D; ++c) a[r*N+c] = linear[r*D+c];
+            a[r*N+D] = offset[r];
+        }
+        a[D*N+D] = T(1);
+        return a;
+    }
+
+    template<typename T, size_t N>
+    constexpr Matrix<T,N,N> ComposeAffine(const Matrix<T,N,N>& a, const Matrix<T,N,N>& b)
+    {
+        // | A s | | B t |   | AB  At + s |
+        // | 0 1 | | 0 1 | = | 0       1  |
+        static_assert(N > 1, "a and b are D+1 x D+1 affine matrices");
+        constexpr size_t D = N - 1;
+        Matrix<T,N,N> ab;
+        for (size_t r = 0; r < D; ++r)
+        {
+            for (size_t c = 0; c < N; ++c)
+            {
+                T sum = a[r*N] * b[c];
+                for (size_t k = 1; k < D; ++k) sum += a[r*N+k] * b[k*N+c];
+                ab[r*N+c] = sum;
+            }
+            ab[r*N+D] += a[r*N+D];
+        }
+        ab[D*N+D] = T(1);
+        return ab;
+    }
+
+    template<typename T, size_t N, size_t D>
+    constexpr Matrix<T,N,N> Scaled(const Matrix<T,N,N>& a, const Point<T,D>& factors)
+    {
+        static_assert(N == D || N == D + 1, "a is a D x D or D+1 x D+1 matrix");
+        auto scaled = a;
+        for (size_t r = 0; r < D; ++r)
+            for (size_t c = 0; c < N; ++c)
+                scaled[r*N+c] *= factors[r];
+        return scaled;
+    }
+
+    template<typename T, size_t D>
+    constexpr Matrix<T,D+1,D+1> Translated(const Matrix<T,D+1,D+1>& a, const Point<T,D>& offset)
+    {
+        auto translated = a;
+        for (size_t r = 0; r < D; ++r) translated[r*(D+1)+D] += offset[r];
+        return translated;
+    }
+
+    template<typename T, size_t D>
+    constexpr Point<T,D> Transform(const Matrix<T,D,D>& a, const Point<T,D>& p)
+    {
+        return detail::TransformPoint(a, p);
+    }
+
+    template<typename T, size_t D>
+    constexpr Point<T,D> Transform(const Matrix<T,D+1,D+1>& a, const Point<T,D>& p)
+    {
+        return detail::TransformPoint(a, p);
+    }
+
+    template<typename T, size_t D>
+    void Transform(const Matrix<T,D,D>& a, const Point<T,D>* in, Point<T,D>* out, size_t count, size_t numThreads)
+    {
+        detail::TransformPoints(a, in, out, count, numThreads);
+    }
+
+    template<typename T, size_t D>
+    void Transform(const Matrix<T,D+1,D+1>& a, const Point<T,D>* in, Point<T,D>* out, size_t count, size_t numThreads)
+    {
+        detail::TransformPoints(a, in, out, count, numThreads);
+    }
+
+    template<typename T, size_t N, size_t D>
+    void Transform(const Matrix<T,N,N>& a, std::span<const Point<T,D>> in, std::span<Point<T,D>> out, size_t numThreads)
+    {
+        static_assert(N == D || N == D + 1, "a is a D x D or D+1 x D+1 matrix");
+        ALWAYS_ASSERT(in.size() == out.size());
+        detail::TransformPoints(a, in.data(), out.data(), in.size(), numThreads);
+    }
+
+    template<typename T, size_t M, size_t N>
+    constexpr void MultiplyAdd(Point<T,M>& y, const Matrix<T,M,N>& a, const Point<T,N>& x, std::type_identity_t<T> alpha, std::type_identity_t<T> beta)
+    {
+        detail::Gemv(M, N, T(alpha), a.Elements.data(), N, x.data(), T(beta), y.data());
+    }
+
+    template<typename T, size_t N, size_t D>
+    PointCloud<T,D>& Transform(const Matrix<T,N,N>& a, PointCloud<T,D>& cloud, size_t numThreads)
+    {
+        ParallelFor(cloud.size(), numThreads, [&](size_t begin, size_t end)
+        {
+            alignas(CacheLineSize) T transformed[D][detail::TransformBlock];
+            std::array<const T*, D> from;
+            std::array<T*, D> to;
+            for (size_t d = 0; d < D; ++d) to[d] = transformed[d];
+
+            for (size_t first = begin; first < end; first += detail::TransformBlock)
+            {
+                const size_t n = std::min(detail::TransformBlock, end - first);
+                for (size_t d = 0; d < D; ++d) from[d] = cloud.data(d) + first;
+                detail::TransformCoordinates(a, from, to, n);
+                for (size_t d = 0; d < D; ++d) std::memcpy(cloud.data(d) + first, transformed[d], n * sizeof(T));
+            }
+        });
+        return cloud;
+    }
+
+}
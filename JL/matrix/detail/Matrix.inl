@@ -5,8 +5,13 @@ Matrix.inl
 #pragma once
 
 #include "JL/utils/Utils.h"
+#include "JL/utils/Simd.h"
+#include "JL/utils/Parallel.h"
+#include "JL/matrix/Gemm.h"
+#include "JL/matrix/LUDecomposition.h"
 
 #include <array>
+#include <type_traits>
 
 namespace jl
 {
@@ -22,110 +27,262 @@ namespace jl
     }
 
     template<typename T, size_t M, size_t N>
-    Matrix<T,M,N> operator+(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs)
+    constexpr Matrix<T,M,N> operator+(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs)
     {
         Matrix<T,M,N> a;
+        if constexpr (simd::UseKernels<T,M*N>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::Add(lhs.Elements.data(), rhs.Elements.data(), a.Elements.data(), M*N);
+                return a;
+            }
+        }
         for (size_t i = 0; i < M*N; ++i)
             a[i] = lhs[i] + rhs[i];
         return a;
     }
 
     template<typename T, size_t M, size_t N>
-    Matrix<T,M,N> operator-(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs)
+    constexpr Matrix<T,M,N> operator-(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs)
     {
         Matrix<T,M,N> a;
+        if constexpr (simd::UseKernels<T,M*N>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::Subtract(lhs.Elements.data(), rhs.Elements.data(), a.Elements.data(), M*N);
+                return a;
+            }
+        }
         for (size_t i = 0; i < M*N; ++i)
             a[i] = lhs[i] - rhs[i];
         return a;
     }
 
     template<typename T, size_t M, size_t N>
-    Matrix<T,M,N> operator*(const Matrix<T,M,N>& lhs, T s)
+    constexpr Matrix<T,M,N> operator*(const Matrix<T,M,N>& lhs, T s)
     {
         Matrix<T,M,N> a;
+        if constexpr (simd::UseKernels<T,M*N>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::Scale(lhs.Elements.data(), s, a.Elements.data(), M*N);
+                return a;
+            }
+        }
         for (size_t i = 0; i < M*N; ++i)
             a[i] = lhs[i] * s;
         return a;
     }
 
     template<typename T, size_t M, size_t N>
-    Matrix<T,M,N> operator*(T s, const Matrix<T,M,N>& rhs)
+    constexpr Matrix<T,M,N> operator*(T s, const Matrix<T,M,N>& rhs)
     {
         return rhs * s;
     }
 
     template<typename T, size_t M, size_t N>
-    Matrix<T,M,N> operator/(const Matrix<T,M,N>& lhs, T s)
+    constexpr Matrix<T,M,N> operator/(const Matrix<T,M,N>& lhs, T s)
     {
         ASSERT(s != 0);
         Matrix<T,M,N> a;
+        if constexpr (simd::UseKernels<T,M*N>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::Divide(lhs.Elements.data(), s, a.Elements.data(), M*N);
+                return a;
+            }
+        }
         for (size_t i = 0; i < M*N; ++i)
             a[i] = lhs[i] / s;
         return a;
     }
 
     template<typename T, size_t M, size_t N>
-    Matrix<T,M,N>& operator+=(Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs)
+    constexpr Matrix<T,M,N>& operator+=(Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs)
     {
+        if constexpr (simd::UseKernels<T,M*N>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::Add(lhs.Elements.data(), rhs.Elements.data(), lhs.Elements.data(), M*N);
+                return lhs;
+            }
+        }
         for (size_t i = 0; i < M*N; ++i)
             lhs[i] += rhs[i];
         return lhs;
     }
 
     template<typename T, size_t M, size_t N>
-    Matrix<T,M,N>& operator-=(Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs)
+    constexpr Matrix<T,M,N>& operator-=(Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs)
     {
+        if constexpr (simd::UseKernels<T,M*N>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::Subtract(lhs.Elements.data(), rhs.Elements.data(), lhs.Elements.data(), M*N);
+                return lhs;
+            }
+        }
         for (size_t i = 0; i < M*N; ++i)
             lhs[i] -= rhs[i];
         return lhs;
     }
 
     template<typename T, size_t M, size_t N>
-    Matrix<T,M,N>& operator*=(Matrix<T,M,N>& lhs, T s)
+    constexpr Matrix<T,M,N>& operator*=(Matrix<T,M,N>& lhs, T s)
     {
+        if constexpr (simd::UseKernels<T,M*N>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::Scale(lhs.Elements.data(), s, lhs.Elements.data(), M*N);
+                return lhs;
+            }
+        }
         for (size_t i = 0; i < M*N; ++i)
             lhs[i] *= s;
         return lhs;
     }
 
     template<typename T, size_t M, size_t N>
-    Matrix<T,M,N>& operator/=(Matrix<T,M,N>& lhs, T s)
+    constexpr Matrix<T,M,N>& operator/=(Matrix<T,M,N>& lhs, T s)
     {
         ASSERT(s != 0);
+        if constexpr (simd::UseKernels<T,M*N>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::Divide(lhs.Elements.data(), s, lhs.Elements.data(), M*N);
+                return lhs;
+            }
+        }
         for (size_t i = 0; i < M*N; ++i)
             lhs[i] /= s;
         return lhs;
     }
 
     template<typename T, size_t M, size_t N>
-    bool operator==(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs)
+    constexpr bool operator==(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs)
     {
         return lhs.Elements == rhs.Elements;
     }
 
     template<typename T, size_t M, size_t N>
-    bool operator!=(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs)
+    constexpr bool operator!=(const Matrix<T,M,N>& lhs, const Matrix<T,M,N>& rhs)
     {
         return !(lhs.Elements == rhs.Elements);
     }
 
     template<typename T, size_t M, size_t N, size_t P> 
-    Matrix<T,M,P> operator*(const Matrix<T,M,N>& a1, const Matrix<T,N,P>& a2)
+    constexpr Matrix<T,M,P> operator*(const Matrix<T,M,N>& a1, const Matrix<T,N,P>& a2)
     {
         Matrix<T,M,P> a;
-        for (size_t m = 0; m < M; ++m)
-            for (size_t p = 0; p < P; ++p)
+        if constexpr (M*N*P >= detail::GemmBlockedThreshold)
+        {
+            if (!std::is_constant_evaluated())
             {
-                T sum = 0;
-                for (size_t n = 0; n < N; ++n)
-                    sum += a1[m*N+n] * a2[n*P+p];
-                a[m*P+p] = sum;
+                detail::GemmBlocked(M, N, P, a1.Elements.data(), N, a2.Elements.data(), P, a.Elements.data(), P);
+                return a;
             }
+        }
+        else if constexpr (0 < N && M <= detail::GemmSmallMax && N <= detail::GemmSmallMax && P <= detail::GemmSmallMax)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                detail::GemmSmall<T,M,N,P>(a1.Elements.data(), a2.Elements.data(), a.Elements.data());
+                return a;
+            }
+        }
+        detail::GemmNaive(M, N, P, a1.Elements.data(), N, a2.Elements.data(), P, a.Elements.data(), P);
         return a;
     }
 
+    template<typename T, size_t M, size_t N, size_t P>
+    Matrix<T,M,P> ParallelMultiply(const Matrix<T,M,N>& a1, const Matrix<T,N,P>& a2, size_t numThreads)
+    {
+        if constexpr (M*N*P < detail::GemmParallelThreshold)
+            return a1 * a2;
+        else
+        {
+            Matrix<T,M,P> a;
+            detail::GemmParallel(M, N, P, a1.Elements.data(), N, a2.Elements.data(), P, a.Elements.data(), P, numThreads);
+            return a;
+        }
+    }
+
+    template<typename T, size_t M, size_t N>
+    constexpr TransposedView<Matrix<T,M,N>> Transposed(const Matrix<T,M,N>& a)
+    {
+        return { a };
+    }
+
+    template<typename T, size_t M, size_t N, size_t P>
+    constexpr Matrix<T,N,P> operator*(TransposedView<Matrix<T,M,N>> a1, const Matrix<T,M,P>& a2)
+    {
+        // a1^T is N x M, element (n, m) is a1.Source[m*N+n]
+        if constexpr (N <= detail::GemmSmallMax && 0 < M && M <= detail::GemmSmallMax && P <= detail::GemmSmallMax)
+            return Transpose(a1.Source) * a2;
+        else
+        {
+            Matrix<T,N,P> a;
+            if constexpr (N*M*P >= detail::GemmBlockedThreshold)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    detail::GemmBlocked(N, M, P, T(1), a1.Source.Elements.data(), 1, N, a2.Elements.data(), P, 1, T(0), a.Elements.data(), P);
+                    return a;
+                }
+            }
+            detail::GemmNaive(N, M, P, T(1), a1.Source.Elements.data(), 1, N, a2.Elements.data(), P, 1, T(0), a.Elements.data(), P);
+            return a;
+        }
+    }
+
+    template<typename T, size_t M, size_t N, size_t P>
+    constexpr Matrix<T,M,P> operator*(const Matrix<T,M,N>& a1, TransposedView<Matrix<T,P,N>> a2)
+    {
+        // a2^T is N x P, element (n, p) is a2.Source[p*N+n]
+        if constexpr (M <= detail::GemmSmallMax && 0 < N && N <= detail::GemmSmallMax && P <= detail::GemmSmallMax)
+            return a1 * Transpose(a2.Source);
+        else
+        {
+            Matrix<T,M,P> a;
+            if constexpr (M*N*P >= detail::GemmBlockedThreshold)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    detail::GemmBlocked(M, N, P, T(1), a1.Elements.data(), N, 1, a2.Source.Elements.data(), 1, N, T(0), a.Elements.data(), P);
+                    return a;
+                }
+            }
+            detail::GemmNaive(M, N, P, T(1), a1.Elements.data(), N, 1, a2.Source.Elements.data(), 1, N, T(0), a.Elements.data(), P);
+            return a;
+        }
+    }
+
+    template<typename T, size_t M, size_t N, size_t P>
+    void MultiplyAdd(Matrix<T,M,P>& c, const Matrix<T,M,N>& a1, const Matrix<T,N,P>& a2, std::type_identity_t<T> alpha, std::type_identity_t<T> beta, size_t numThreads)
+    {
+        ASSERT(static_cast<const void*>(&c) != &a1 && static_cast<const void*>(&c) != &a2);
+        if constexpr (0 < N && M <= detail::GemmSmallMax && N <= detail::GemmSmallMax && P <= detail::GemmSmallMax)
+        {
+            // a product this small lives in registers, only the combination with c matters
+            Matrix<T,M,P> a;
+            detail::GemmSmall<T,M,N,P>(a1.Elements.data(), a2.Elements.data(), a.Elements.data());
+            for (size_t i = 0; i < M*P; ++i)
+                c[i] = beta == T(0) ? alpha * a[i] : alpha * a[i] + beta * c[i];
+        }
+        else
+            detail::GemmParallel(M, N, P, alpha, a1.Elements.data(), N, a2.Elements.data(), P, beta, c.Elements.data(), P, numThreads);
+    }
+
     template<typename T, size_t M, size_t N> 
-    Matrix<T,M,N> DiagonalMatrix(T v)
+    constexpr Matrix<T,M,N> DiagonalMatrix(T v)
     {
         Matrix<T,M,N> a;
         for (size_t m = 0; m < M; ++m)
@@ -135,26 +292,42 @@ namespace jl
     }
 
     template<typename T, size_t M, size_t N>
-    bool IsDiagonalMatrix(const Matrix<T,M,N>& a)
+    constexpr bool IsDiagonalMatrix(const Matrix<T,M,N>& a)
     {
         ASSERT(a.size() > 0);
         return a == DiagonalMatrix<T,M,N>(a[0]);
     }
     
     template<typename T, size_t M, size_t N>
-    Matrix<T,M,N> IdentityMatrix()
+    constexpr Matrix<T,M,N> IdentityMatrix()
     {
         return DiagonalMatrix<T,M,N>(T(1));
     }
 
     template<typename T, size_t M, size_t N>
-    Matrix<T,N,M> Transpose(const Matrix<T,M,N>& a)
+    constexpr Matrix<T,N,M> Transpose(const Matrix<T,M,N>& a)
     {
-        return Matrix<T,N,M>{a.Elements};
+        Matrix<T,N,M> t;
+        if constexpr (M*N >= detail::TransposeBlockedThreshold)
+            detail::TransposeBlocked(M, N, a.Elements.data(), N, t.Elements.data(), M);
+        else
+        {
+            for (size_t m = 0; m < M; ++m)
+                for (size_t n = 0; n < N; ++n)
+                    t[n*M+m] = a[m*N+n];
+        }
+        return t;
+    }
+
+    template<typename T, size_t N>
+    constexpr Matrix<T,N,N>& TransposeInPlace(Matrix<T,N,N>& a)
+    {
+        detail::TransposeSquareInPlace(N, a.Elements.data(), N);
+        return a;
     }
 
     template<typename T, size_t M, size_t N> 
-    Matrix<T,M-1,N-1> Submatrix(const Matrix<T,M,N>& a, int rowToRemove, int columnToRemove)
+    constexpr Matrix<T,M-1,N-1> Submatrix(const Matrix<T,M,N>& a, int rowToRemove, int columnToRemove)
     {
         ASSERT(0 <= rowToRemove && rowToRemove < M);
         ASSERT(0 <= columnToRemove && columnToRemove < N);
@@ -173,34 +346,273 @@ namespace jl
         return submatrix;
     }
 
+    namespace detail
+    {
+        // Laplace expansion along the first row, O(M!). Kept as the reference for the closed forms and LU.
+        template<typename T, size_t M>
+        constexpr T DeterminantCofactor(const Matrix<T,M,M>& a)
+        {
+            if constexpr (M == 0) return T(1);
+            else if constexpr (M == 1) return a[0];
+            else
+            {
+                T d(0);
+                for (size_t i = 0; i < M; ++i)
+                {
+                    auto minor = Submatrix(a, 0, int(i));
+                    if (i % 2) d -= (a[i] * DeterminantCofactor(minor));
+                    else       d += (a[i] * DeterminantCofactor(minor));
+                }
+                return d;
+            }
+        }
+
+        // Closed form determinant of a row-major 2x2, 3x3 or 4x4 a. V is the element type or Lanes of it.
+        template<size_t N, typename V>
+        constexpr V DeterminantClosedForm(const V* a)
+        {
+            static_assert(2 <= N && N <= 4, "closed form determinant is only defined for 2x2, 3x3 and 4x4");
+
+            if constexpr (N == 2)
+            {
+                return a[0]*a[3] - a[1]*a[2];
+            }
+            else if constexpr (N == 3)
+            {
+                return a[0]*(a[4]*a[8] - a[5]*a[7])
+                     - a[1]*(a[3]*a[8] - a[5]*a[6])
+                     + a[2]*(a[3]*a[7] - a[4]*a[6]);
+            }
+            else
+            {
+                // Laplace expansion over the 2x2 minors of the top two rows and their complements in the bottom two
+                const V s0 = a[0]*a[5] - a[4]*a[1];
+                const V s1 = a[0]*a[6] - a[4]*a[2];
+                const V s2 = a[0]*a[7] - a[4]*a[3];
+                const V s3 = a[1]*a[6] - a[5]*a[2];
+                const V s4 = a[1]*a[7] - a[5]*a[3];
+                const V s5 = a[2]*a[7] - a[6]*a[3];
+
+                const V c5 = a[10]*a[15] - a[14]*a[11];
+                const V c4 = a[9]*a[15] - a[13]*a[11];
+                const V c3 = a[9]*a[14] - a[13]*a[10];
+                const V c2 = a[8]*a[15] - a[12]*a[11];
+                const V c1 = a[8]*a[14] - a[12]*a[10];
+                const V c0 = a[8]*a[13] - a[12]*a[9];
+
+                return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+            }
+        }
+    }
+
     template<typename T, size_t M> 
-    T Determinant(const Matrix<T,M,M>& a)
+    constexpr T Determinant(const Matrix<T,M,M>& a)
     {
-        T d(0);
+        if constexpr (M == 0)
+        {
+            return T(1);
+        }
+        else if constexpr (M == 1)
+        {
+            return a[0];
+        }
+        else if constexpr (M <= 4)
+        {
+            return detail::DeterminantClosedForm<M>(a.Elements.data());
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            return Determinant(LUDecompose(a));
+        }
+        else
+        {
+            // LU would truncate integer pivots, the fraction-free elimination stays exact
+            return DeterminantBareiss(a);
+        }
+    }
 
-        if(M > 2)
+    namespace detail
+    {
+        // L values of T that behave like one, the batched closed form inverts L matrices in lockstep with it
+        template<typename T, size_t L>
+        struct Lanes
         {
-            for(size_t i = 0; i < M; ++i)
+            T v[L];
+        };
+
+        #define JL_LANES_OPERATOR(op) \
+            template<typename T, size_t L> \
+            Lanes<T,L> operator op(const Lanes<T,L>& lhs, const Lanes<T,L>& rhs) \
+            { \
+                Lanes<T,L> r; \
+                for (size_t i = 0; i < L; ++i) r.v[i] = lhs.v[i] op rhs.v[i]; \
+                return r; \
+            }
+        JL_LANES_OPERATOR(+)
+        JL_LANES_OPERATOR(-)
+        JL_LANES_OPERATOR(*)
+        #undef JL_LANES_OPERATOR
+
+        template<typename T, size_t L>
+        Lanes<T,L> operator-(const Lanes<T,L>& a)
+        {
+            Lanes<T,L> r;
+            for (size_t i = 0; i < L; ++i) r.v[i] = -a.v[i];
+            return r;
+        }
+
+        template<typename T> T Reciprocal(T a) { ASSERT(a != T(0)); return T(1) / a; }
+
+        template<typename T, size_t L>
+        Lanes<T,L> Reciprocal(const Lanes<T,L>& a)
+        {
+            Lanes<T,L> r;
+            for (size_t i = 0; i < L; ++i) r.v[i] = T(1) / a.v[i];
+            for (size_t i = 0; i < L; ++i) ASSERT(a.v[i] != T(0));
+            return r;
+        }
+
+        /*
+        Closed form inverse (adjugate / determinant) with no branches. V is the element type or Lanes of
+        it. All elements are loaded before any is stored, so a and inverse may be the same buffer.
+        */
+        template<size_t N, typename V>
+        void InverseClosedForm(const V* a, V* inverse)
+        {
+            static_assert(2 <= N && N <= 4, "closed form inverse is only defined for 2x2, 3x3 and 4x4");
+
+            if constexpr (N == 2)
             {
-                auto minor = Submatrix(a,0,i);
-                
-                ASSERT(a.NumRows() == a.NumColumns());
-                ASSERT(a.NumRows() == M-1);
+                const V a00 = a[0], a01 = a[1];
+                const V a10 = a[2], a11 = a[3];
 
-                if(i % 2) d += (a[i] * Determinant(minor));
-                else      d -= (a[i] * Determinant(minor));
+                const V invDet = Reciprocal(a00*a11 - a01*a10);
+
+                inverse[0] =  a11 * invDet; inverse[1] = -a01 * invDet;
+                inverse[2] = -a10 * invDet; inverse[3] =  a00 * invDet;
+            }
+            else if constexpr (N == 3)
+            {
+                const V a00 = a[0], a01 = a[1], a02 = a[2];
+                const V a10 = a[3], a11 = a[4], a12 = a[5];
+                const V a20 = a[6], a21 = a[7], a22 = a[8];
+
+                // cofactors of the first column, reused by the determinant
+                const V c00 = a11*a22 - a12*a21;
+                const V c10 = a12*a20 - a10*a22;
+                const V c20 = a10*a21 - a11*a20;
+
+                const V invDet = Reciprocal(a00*c00 + a01*c10 + a02*c20);
+
+                inverse[0] = c00 * invDet;
+                inverse[1] = (a02*a21 - a01*a22) * invDet;
+                inverse[2] = (a01*a12 - a02*a11) * invDet;
+                inverse[3] = c10 * invDet;
+                inverse[4] = (a00*a22 - a02*a20) * invDet;
+                inverse[5] = (a02*a10 - a00*a12) * invDet;
+                inverse[6] = c20 * invDet;
+                inverse[7] = (a01*a20 - a00*a21) * invDet;
+                inverse[8] = (a00*a11 - a01*a10) * invDet;
+            }
+            else
+            {
+                const V a00 = a[0],  a01 = a[1],  a02 = a[2],  a03 = a[3];
+                const V a10 = a[4],  a11 = a[5],  a12 = a[6],  a13 = a[7];
+                const V a20 = a[8],  a21 = a[9],  a22 = a[10], a23 = a[11];
+                const V a30 = a[12], a31 = a[13], a32 = a[14], a33 = a[15];
+
+                // the same 2x2 minors as the 4x4 Determinant
+                const V s0 = a00*a11 - a10*a01;
+                const V s1 = a00*a12 - a10*a02;
+                const V s2 = a00*a13 - a10*a03;
+                const V s3 = a01*a12 - a11*a02;
+                const V s4 = a01*a13 - a11*a03;
+                const V s5 = a02*a13 - a12*a03;
+
+                const V c5 = a22*a33 - a32*a23;
+                const V c4 = a21*a33 - a31*a23;
+                const V c3 = a21*a32 - a31*a22;
+                const V c2 = a20*a33 - a30*a23;
+                const V c1 = a20*a32 - a30*a22;
+                const V c0 = a20*a31 - a30*a21;
+
+                const V invDet = Reciprocal(s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0);
+
+                inverse[0]  = ( a11*c5 - a12*c4 + a13*c3) * invDet;
+                inverse[1]  = (-a01*c5 + a02*c4 - a03*c3) * invDet;
+                inverse[2]  = ( a31*s5 - a32*s4 + a33*s3) * invDet;
+                inverse[3]  = (-a21*s5 + a22*s4 - a23*s3) * invDet;
+
+                inverse[4]  = (-a10*c5 + a12*c2 - a13*c1) * invDet;
+                inverse[5]  = ( a00*c5 - a02*c2 + a03*c1) * invDet;
+                inverse[6]  = (-a30*s5 + a32*s2 - a33*s1) * invDet;
+                inverse[7]  = ( a20*s5 - a22*s2 + a23*s1) * invDet;
+
+                inverse[8]  = ( a10*c4 - a11*c2 + a13*c0) * invDet;
+                inverse[9]  = (-a00*c4 + a01*c2 - a03*c0) * invDet;
+                inverse[10] = ( a30*s4 - a31*s2 + a33*s0) * invDet;
+                inverse[11] = (-a20*s4 + a21*s2 - a23*s0) * invDet;
+
+                inverse[12] = (-a10*c3 + a11*c1 - a12*c0) * invDet;
+                inverse[13] = ( a00*c3 - a01*c1 + a02*c0) * invDet;
+                inverse[14] = (-a30*s3 + a31*s1 - a32*s0) * invDet;
+                inverse[15] = ( a20*s3 - a21*s1 + a22*s0) * invDet;
             }
         }
-        else if(M == 2)
+
+        // Matrices per call of the batched closed form
+        constexpr size_t InverseBatchLanes = 8;
+    }
+
+    template<typename T, size_t N>
+    Matrix<T,N,N>& InverseMatrix(Matrix<T,N,N>& a)
+    {
+        static_assert(std::is_floating_point_v<T>, "InverseMatrix requires a floating point type");
+
+        if constexpr (N == 1)
+        {
+            ASSERT(a[0] != T(0));
+            a[0] = T(1) / a[0];
+        }
+        else if constexpr (2 <= N && N <= 4)
         {
-            d = a[0]*a[3] - a[1]*a[2];
+            detail::InverseClosedForm<N>(a.Elements.data(), a.Elements.data());
         }
-        else if(M == 1)
+        else if constexpr (N > 4)
         {
-            d = a[0];
+            a = Inverse(LUDecompose(a));
         }
-        
-        return d;
+        return a;
+    }
+
+    template<typename T, size_t N>
+    void InverseMatrix(Matrix<T,N,N>* a, size_t count, size_t numThreads)
+    {
+        static_assert(std::is_floating_point_v<T>, "InverseMatrix requires a floating point type");
+
+        ParallelFor(count, numThreads, [&](size_t i, size_t end)
+        {
+            if constexpr (2 <= N && N <= 4)
+            {
+                // transpose L matrices into lanes, element k of all of them side by side
+                constexpr size_t L = detail::InverseBatchLanes;
+                for (; i + L <= end; i += L)
+                {
+                    detail::Lanes<T,L> lanes[N*N];
+                    for (size_t l = 0; l < L; ++l)
+                        for (size_t k = 0; k < N*N; ++k)
+                            lanes[k].v[l] = a[i+l][k];
+
+                    detail::InverseClosedForm<N>(lanes, lanes);
+
+                    for (size_t l = 0; l < L; ++l)
+                        for (size_t k = 0; k < N*N; ++k)
+                            a[i+l][k] = lanes[k].v[l];
+                }
+            }
+            for (; i < end; ++i)
+                InverseMatrix(a[i]);
+        }, detail::InverseBatchLanes * 128);
     }
 
 }
\ No newline at end of file
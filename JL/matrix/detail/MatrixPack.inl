@@ -0,0 +1,141 @@
+/*
+MatrixPack.inl
+*/
+
+#pragma once
+
+#include "JL/utils/Utils.h"
+#include "JL/utils/Parallel.h"
+
+#include <type_traits>
+
+namespace jl
+{
+    namespace detail
+    {
+        // Matrices per thread before a batch is split
+        constexpr size_t MatrixBatchPerThread = 1024;
+    }
+
+    template<typename T, size_t N, size_t L>
+    MatrixPack<T,N,L>::MatrixPack(const Matrix<T,N,N>* matrices)
+    {
+        for (size_t l = 0; l < L; ++l)
+            for (size_t k = 0; k < N*N; ++k)
+                Elements[k].v[l] = matrices[l][k];
+    }
+
+    template<typename T, size_t N, size_t L>
+    Matrix<T,N,N> MatrixPack<T,N,L>::operator[](size_t l) const
+    {
+        ASSERT(l < L);
+        Matrix<T,N,N> a;
+        for (size_t k = 0; k < N*N; ++k) a[k] = Elements[k].v[l];
+        return a;
+    }
+
+    template<typename T, size_t N, size_t L>
+    void MatrixPack<T,N,L>::Set(size_t l, const Matrix<T,N,N>& a)
+    {
+        ASSERT(l < L);
+        for (size_t k = 0; k < N*N; ++k) Elements[k].v[l] = a[k];
+    }
+
+    template<typename T, size_t N, size_t L>
+    void MatrixPack<T,N,L>::ToMatrices(Matrix<T,N,N>* out) const
+    {
+        for (size_t l = 0; l < L; ++l)
+            for (size_t k = 0; k < N*N; ++k)
+                out[l][k] = Elements[k].v[l];
+    }
+
+    template<typename T, size_t N, size_t L>
+    MatrixPack<T,N,L> operator*(const MatrixPack<T,N,L>& a, const MatrixPack<T,N,L>& b)
+    {
+        // the same order of accumulation as GemmNaive
+        MatrixPack<T,N,L> c;
+        for (size_t r = 0; r < N; ++r)
+            for (size_t col = 0; col < N; ++col)
+            {
+                auto sum = a.Elements[r*N] * b.Elements[col];
+                for (size_t k = 1; k < N; ++k)
+                    sum = sum + a.Elements[r*N+k] * b.Elements[k*N+col];
+                c.Elements[r*N+col] = sum;
+            }
+        return c;
+    }
+
+    template<typename T, size_t N, size_t L>
+    MatrixPack<T,N,L> Transpose(const MatrixPack<T,N,L>& a)
+    {
+        MatrixPack<T,N,L> t;
+        for (size_t r = 0; r < N; ++r)
+            for (size_t c = 0; c < N; ++c)
+                t.Elements[c*N+r] = a.Elements[r*N+c];
+        return t;
+    }
+
+    template<typename T, size_t N, size_t L>
+    std::array<T,L> Determinant(const MatrixPack<T,N,L>& a)
+    {
+        const auto d = detail::DeterminantClosedForm<N>(a.Elements.data());
+        std::array<T,L> out;
+        for (size_t l = 0; l < L; ++l) out[l] = d.v[l];
+        return out;
+    }
+
+    template<typename T, size_t N, size_t L>
+    MatrixPack<T,N,L>& InverseMatrix(MatrixPack<T,N,L>& a)
+    {
+        static_assert(std::is_floating_point_v<T>, "InverseMatrix requires a floating point type");
+        detail::InverseClosedForm<N>(a.Elements.data(), a.Elements.data());
+        return a;
+    }
+
+    // The batches below run the unrolled kernel of one matrix at a time, packing and unpacking costs more
+    // than the lanes save for these operations (Benchmark 8)
+
+    template<typename T, size_t N>
+    void Multiply(const Matrix<T,N,N>* a, const Matrix<T,N,N>* b, Matrix<T,N,N>* out, size_t count, size_t numThreads)
+    {
+        ParallelFor(count, numThreads, [&](size_t begin, size_t end)
+        {
+            // one product buffer for the whole range, out may be a or b
+            Matrix<T,N,N> product;
+            for (size_t i = begin; i < end; ++i)
+            {
+                if constexpr (N <= detail::GemmSmallMax)
+                    detail::GemmSmall<T,N,N,N>(a[i].Elements.data(), b[i].Elements.data(), product.Elements.data());
+                else
+                    product = a[i] * b[i];
+                out[i] = product;
+            }
+        }, detail::MatrixBatchPerThread);
+    }
+
+    template<typename T, size_t N>
+    void Transpose(const Matrix<T,N,N>* a, Matrix<T,N,N>* out, size_t count, size_t numThreads)
+    {
+        ParallelFor(count, numThreads, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const Matrix<T,N,N> m = a[i];
+                for (size_t r = 0; r < N; ++r)
+                    for (size_t c = 0; c < N; ++c)
+                        out[i][c*N+r] = m[r*N+c];
+            }
+        }, detail::MatrixBatchPerThread);
+    }
+
+    template<typename T, size_t N>
+    void Determinant(const Matrix<T,N,N>* a, T* out, size_t count, size_t numThreads)
+    {
+        static_assert(2 <= N && N <= 4, "batched Determinant is for 2x2, 3x3 and 4x4");
+        ParallelFor(count, numThreads, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i) out[i] = Determinant(a[i]);
+        }, detail::MatrixBatchPerThread);
+    }
+
+}
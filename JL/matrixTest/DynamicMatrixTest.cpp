@@ -0,0 +1,199 @@
+/*
+DynamicMatrixTest.cpp
+*/
+
+#include "JL/matrix/DynamicMatrix.h"
+#include "JL/matrix/RandomMatrix.h"
+#include "JL/utils/ThreadPool.h"
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace jl;
+
+void TestDynamicMatrix()
+{
+    std::cout << "##### Dynamic Matrix Test #####\n";
+
+    using T = int32_t;
+    const T min = -10, max = 10;
+
+    uniform_dist<T> rnInt32(min, max);
+    auto reng = GetRandomEngine();
+
+    static_assert(!std::is_copy_constructible_v<DynamicMatrix<T>>, "DynamicMatrix is move only");
+    static_assert(std::is_nothrow_move_constructible_v<DynamicMatrix<T>>, "DynamicMatrix moves without allocating");
+
+    // Construction, conversion and ownership
+    {
+        std::cout << "Test 1: Construction test\n";
+
+        DynamicMatrix<T> a(3, 4);
+        ALWAYS_ASSERT(a.NumRows() == 3 && a.NumColumns() == 4 && a.size() == 12);
+        for (size_t i = 0; i < a.size(); ++i) ALWAYS_ASSERT(a[i] == 0);
+        ALWAYS_ASSERT(reinterpret_cast<uintptr_t>(a.data()) % CacheLineSize == 0);
+
+        auto fixed = RandomMatrix<T,3,4>(reng, min, max);
+        DynamicMatrix<T> b(fixed);
+        ALWAYS_ASSERT((b.ToMatrix<3,4>() == fixed));
+        ALWAYS_ASSERT(b(2, 1) == fixed[2*4+1]);
+
+        auto c = b.Clone();
+        ALWAYS_ASSERT(c == b);
+        const T* storage = c.data();
+        DynamicMatrix<T> d(std::move(c));
+        ALWAYS_ASSERT(d.data() == storage);
+        ALWAYS_ASSERT(d == b && d != a);
+    }
+
+    // Same results as the fixed-size operators
+    {
+        std::cout << "Test 2: Operator test\n";
+
+        const size_t M = 5, N = 7, P = 3;
+        for (size_t i = 0; i < 100; ++i)
+        {
+            auto fa = RandomMatrix<T,M,N>(reng, min, max);
+            auto fb = RandomMatrix<T,M,N>(reng, min, max);
+            auto fc = RandomMatrix<T,N,P>(reng, min, max);
+            T s = rnInt32(reng);
+            if (s == 0) ++s;
+
+            DynamicMatrix<T> a(fa), b(fb), c(fc);
+            ALWAYS_ASSERT(((a + b).ToMatrix<M,N>() == fa + fb));
+            ALWAYS_ASSERT(((a - b).ToMatrix<M,N>() == fa - fb));
+            ALWAYS_ASSERT(((a * s).ToMatrix<M,N>() == fa * s));
+            ALWAYS_ASSERT(((s * a).ToMatrix<M,N>() == fa * s));
+            ALWAYS_ASSERT(((a / s).ToMatrix<M,N>() == fa / s));
+            ALWAYS_ASSERT(((a * c).ToMatrix<M,P>() == fa * fc));
+            ALWAYS_ASSERT(((fa * c).ToMatrix<M,P>() == fa * fc));
+            ALWAYS_ASSERT(((a * fc).ToMatrix<M,P>() == fa * fc));
+
+            auto e = a.Clone();
+            e += b; e -= a; e *= s; e /= s;
+            ALWAYS_ASSERT(e == b);
+
+            auto t = Transpose(a);
+            ALWAYS_ASSERT(t.NumRows() == N && t.NumColumns() == M);
+            for (size_t m = 0; m < M; ++m)
+                for (size_t n = 0; n < N; ++n)
+                    ALWAYS_ASSERT(t(n, m) == a(m, n));
+        }
+
+        // large enough for the blocked kernel
+        auto a = RandomDynamicMatrix<T>(reng, 70, 90, min, max);
+        auto b = RandomDynamicMatrix<T>(reng, 90, 40, min, max);
+        DynamicMatrix<T> expected(70, 40);
+        detail::GemmNaive(size_t(70), size_t(90), size_t(40), a.data(), 90, b.data(), 40, expected.data(), 40);
+        ALWAYS_ASSERT(a * b == expected);
+
+        // transposes and products through a transposed view, small and blocked
+        for (size_t n : { 5, 70 })
+        {
+            auto x = RandomDynamicMatrix<T>(reng, n, 45, min, max);
+            auto y = RandomDynamicMatrix<T>(reng, n, 30, min, max);
+            auto z = RandomDynamicMatrix<T>(reng, 30, 45, min, max);
+            ALWAYS_ASSERT(Transpose(Transpose(x)) == x);
+            ALWAYS_ASSERT(Transposed(x) * y == Transpose(x) * y);
+            ALWAYS_ASSERT(x * Transposed(z) == x * Transpose(z));
+            ALWAYS_ASSERT(Transposed(x) * x == Transpose(x) * x);
+
+            auto square = RandomDynamicMatrix<T>(reng, n, n, min, max);
+            auto inPlace = square.Clone();
+            ALWAYS_ASSERT(TransposeInPlace(inPlace) == Transpose(square));
+        }
+    }
+
+    // Determinant and inverse
+    {
+        std::cout << "Test 3: Determinant and inverse test\n";
+
+        for (size_t i = 0; i < 100; ++i)
+        {
+            auto f3 = RandomMatrix<T,3,3>(reng, min, max);
+            auto f6 = RandomMatrix<T,6,6>(reng, min, max);
+            ALWAYS_ASSERT(Determinant(DynamicMatrix<T>(f3)) == Determinant(f3));
+            ALWAYS_ASSERT(Determinant(DynamicMatrix<T>(f6)) == Determinant(f6));
+        }
+
+        using F = double;
+        for (size_t n : { 1, 2, 3, 4, 5, 9 })
+        {
+            auto a = RandomDynamicMatrix<F>(reng, n, n, -10.0, 10.0);
+            if (std::abs(Determinant(a)) < 1e-3) continue;
+
+            auto inverse = a.Clone();
+            InverseMatrix(inverse);
+            auto identity = a * inverse;
+            for (size_t r = 0; r < n; ++r)
+                for (size_t c = 0; c < n; ++c)
+                    ALWAYS_ASSERT(std::abs(identity(r, c) - (r == c ? F(1) : F(0))) <= 1e-9);
+        }
+        ALWAYS_ASSERT(Determinant(DynamicMatrix<F>(7, 7)) == 0);
+    }
+
+    // Multithreaded products and the pool behind them
+    {
+        std::cout << "Test 4: Parallel multiplication test\n";
+
+        // every task runs exactly once, also with more threads than tasks and from inside a task
+        std::vector<std::atomic<int>> runs(1000);
+        ThreadPool::Shared().Run(runs.size(), 4, [&](size_t task)
+        {
+            ++runs[task];
+            if (task % 250 == 0) ThreadPool::Shared().Run(3, 4, [&](size_t) {});
+        });
+        ThreadPool::Shared().Run(3, 8, [&](size_t task) { ++runs[task]; });
+        for (size_t i = 0; i < runs.size(); ++i)
+            ALWAYS_ASSERT(runs[i] == (i < 3 ? 2 : 1));
+
+        // a throwing task reaches the caller after the others have finished, and the pool stays usable
+        for (size_t threads : { 1, 4 })
+        {
+            bool thrown = false;
+            try { ThreadPool::Shared().Run(100, threads, [](size_t task) { if (task == 37) throw std::runtime_error("task"); }); }
+            catch (const std::runtime_error&) { thrown = true; }
+            ALWAYS_ASSERT(thrown);
+        }
+
+        auto a = RandomDynamicMatrix<T>(reng, 300, 200, min, max);
+        auto b = RandomDynamicMatrix<T>(reng, 200, 333, min, max);
+        DynamicMatrix<T> expected(300, 333);
+        detail::GemmNaive(size_t(300), size_t(200), size_t(333), a.data(), 200, b.data(), 333, expected.data(), 333);
+        for (size_t threads : { 0, 1, 2, 3, 7 })
+            ALWAYS_ASSERT(ParallelMultiply(a, b, threads) == expected);
+
+        // tiles keep the order of accumulation, the thread count does not change floating point results
+        using F = double;
+        auto af = RandomDynamicMatrix<F>(reng, 257, 300, -1.0, 1.0);
+        auto bf = RandomDynamicMatrix<F>(reng, 300, 513, -1.0, 1.0);
+        const auto serial = af * bf;
+        for (size_t threads : { 2, 4 })
+            ALWAYS_ASSERT(ParallelMultiply(af, bf, threads) == serial);
+    }
+
+    // In place c = alpha * a * b + beta * c
+    {
+        std::cout << "Test 5: Multiply add test\n";
+
+        for (auto [m, n, p] : { std::array<size_t,3>{ 5, 7, 3 }, { 64, 300, 1 }, { 70, 90, 40 }, { 300, 200, 333 } })
+        {
+            auto a = RandomDynamicMatrix<T>(reng, m, n, min, max);
+            auto b = RandomDynamicMatrix<T>(reng, n, p, min, max);
+            auto c = RandomDynamicMatrix<T>(reng, m, p, min, max);
+            const T* storage = c.data();
+
+            auto expected = a * b * 4 + c * 5;
+            MultiplyAdd(c, a, b, 4, 5, 3);
+            ALWAYS_ASSERT(c == expected && c.data() == storage);
+
+            expected = c + a * b;
+            MultiplyAdd(c, a, b);
+            ALWAYS_ASSERT(c == expected);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+/*
+LUDecompositionTest.cpp
+*/
+
+#include "JL/matrix/LUDecomposition.h"
+#include "JL/matrix/RandomMatrix.h"
+
+#include <cmath>
+#include <iostream>
+
+using namespace jl;
+
+void TestLUDecomposition()
+{
+    std::cout << "##### LU Decomposition Test #####\n";
+
+    using T = double;
+    const size_t N = 6;
+    const T min = -10, max = 10;
+    const T tolerance = 1e-9;
+
+    auto reng = GetRandomEngine();
+
+    // PA = LU
+    {
+        std::cout << "Test 1: Reconstruction test\n";
+
+        for (size_t i = 0; i < 100; ++i)
+        {
+            auto a = RandomMatrix<T,N,N>(reng, min, max);
+            auto lu = LUDecompose(a);
+            ALWAYS_ASSERT(!lu.IsSingular);
+
+            Matrix<T,N,N> l, u;
+            for (size_t r = 0; r < N; ++r)
+                for (size_t c = 0; c < N; ++c)
+                {
+                    if (r > c) l[r*N+c] = lu.LU[r*N+c];
+                    else       u[r*N+c] = lu.LU[r*N+c];
+                    if (r == c) l[r*N+c] = 1;
+                }
+
+            auto product = l * u;
+            for (size_t r = 0; r < N; ++r)
+                for (size_t c = 0; c < N; ++c)
+                    ALWAYS_ASSERT(std::abs(product[r*N+c] - a[lu.Pivots[r]*N+c]) <= tolerance);
+        }
+    }
+
+    // Ax = b
+    {
+        std::cout << "Test 2: Solve test\n";
+
+        for (size_t i = 0; i < 100; ++i)
+        {
+            auto a = RandomMatrix<T,N,N>(reng, min, max);
+            auto x = RandomPoint<T,N>(reng, min, max);
+
+            Point<T,N> b;
+            for (size_t r = 0; r < N; ++r)
+            {
+                b[r] = 0;
+                for (size_t c = 0; c < N; ++c) b[r] += a[r*N+c] * x[c];
+            }
+
+            auto solved = Solve(LUDecompose(a), b);
+            for (size_t r = 0; r < N; ++r)
+                ALWAYS_ASSERT(std::abs(solved[r] - x[r]) <= 1e-6);
+        }
+    }
+
+    // Singular matrices
+    {
+        std::cout << "Test 3: Singular matrix test\n";
+
+        auto a = RandomMatrix<T,N,N>(reng, min, max);
+        for (size_t c = 0; c < N; ++c) a[3*N+c] = 2 * a[1*N+c];
+
+        auto lu = LUDecompose(a);
+        ALWAYS_ASSERT(lu.IsSingular || std::abs(Determinant(lu)) <= tolerance);
+        ALWAYS_ASSERT(Determinant(LUDecompose(Matrix<T,N,N>())) == 0);
+        ALWAYS_ASSERT(DeterminantBareiss(Matrix<int32_t,N,N>()) == 0);
+    }
+}
@@ -3,35 +3,203 @@ LinearTransformationTest.cpp
 */
 
 #include "JL/matrix/LinearTransformation.h"
+#include "JL/matrix/RandomMatrix.h"
 #include "JL/geometry/Point.h"
+#include "JL/geometry/Random.h"
 
+#include "JL/utils/Parallel.h"
 #include "JL/utils//Utils.h"
 
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
 using namespace jl;
 
 void TestTransformation()
 {
-    // scaling
+    std::cout << "##### Linear Transformation Test #####\n";
+
+    // single points
+    {
+        std::cout << "Test 1: Transform test\n";
+
+        using T = int32_t;
+
+        const Matrix<T,3,3> a(1, 2, 3,
+                              4, 5, 6,
+                              7, 8, 9);
+        ALWAYS_ASSERT((Transform(a, Point<T,3>{ 1, 0, -1 }) == Point<T,3>{ -2, -2, -2 }));
+        ALWAYS_ASSERT((Transform(IdentityMatrix<T,3,3>(), Point<T,3>{ 4, 5, 6 }) == Point<T,3>{ 4, 5, 6 }));
+
+        // rotate a quarter turn about z, then move by (10, 20, 30)
+        const Matrix<T,4,4> affine(0, -1, 0, 10,
+                                   1,  0, 0, 20,
+                                   0,  0, 1, 30,
+                                   0,  0, 0,  1);
+        ALWAYS_ASSERT((Transform(affine, Point<T,3>{ 1, 2, 3 }) == Point<T,3>{ 8, 21, 33 }));
+    }
+
+    // batches against single points, at every instruction set the CPU supports
     {
-        //using T = int32_t;
+        std::cout << "Test 2: Batch transform test\n";
 
-        //const T k = 3;
-        //const size_t D = 3;
+        using T = float;
+        const size_t D = 3;
 
-        //auto v = UnitPoint<T, 3>();
-        //auto A = ScaleMatrix<T, 3>(k);
+        auto reng = GetRandomEngine();
+        const auto a = RandomMatrix<T,D,D>(reng, -2, 2);
+        const auto affine = RandomMatrix<T,D+1,D+1>(reng, -2, 2);
 
-        //auto p4 = Repeat<T, 2>(k);
-        //auto p5 = k * UnitPoint<T, 3>();
+        // a tail after the last block, and enough points for several threads
+        for (size_t count : { size_t(1), size_t(2500), size_t(20001) })
+        {
+            std::vector<Point<T,D>> points(count);
+            for (auto& p : points) p = RandomPoint<T,D>(reng, -10, 10);
 
-        /*ALWAYS_ASSERT(p2 == p4);
-        ALWAYS_ASSERT(p3 == p5);*/
+            std::vector<Point<T,D>> expected(count), expectedAffine(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                expected[i] = Transform(a, points[i]);
+                expectedAffine[i] = Transform(affine, points[i]);
+            }
 
+            const auto detected = simd::DetectSimdLevel();
+            for (int level = 0; level <= static_cast<int>(detected); ++level)
+            {
+                simd::SetSimdLevel(static_cast<simd::SimdLevel>(level));
+                for (size_t threads : { 1, 4 })
+                {
+                    std::vector<Point<T,D>> out(count);
+                    Transform(a, points.data(), out.data(), count, threads);
+                    ALWAYS_ASSERT(out == expected);
+                    Transform(affine, std::span<const Point<T,D>>(points), std::span<Point<T,D>>(out), threads);
+                    ALWAYS_ASSERT(out == expectedAffine);
+
+                    // in place
+                    out = points;
+                    Transform(affine, out.data(), out.data(), count, threads);
+                    ALWAYS_ASSERT(out == expectedAffine);
+
+                    // exact, the Simd.h kernels round the products and sums like the per point loop
+                    PointCloud<T,D> cloud(points);
+                    ALWAYS_ASSERT(Transform(a, cloud, threads).ToPoints() == expected);
+                    cloud = PointCloud<T,D>(points);
+                    ALWAYS_ASSERT(Transform(affine, cloud, threads).ToPoints() == expectedAffine);
+                }
+            }
+            simd::SetSimdLevel(detected);
+        }
+
+        // the ranges of a batch cover the count once, and a throwing range reaches the caller after the others
+        std::atomic<size_t> total = 0;
+        ParallelFor(100000, 4, [&](size_t begin, size_t end) { total += end - begin; }, 1000);
+        ALWAYS_ASSERT(total == 100000);
+        for (size_t threads : { 1, 4 })
+        {
+            bool thrown = false;
+            try { ParallelFor(100000, threads, [](size_t begin, size_t) { if (begin > 0) throw std::runtime_error("range"); }, 1000); }
+            catch (const std::runtime_error&) { thrown = true; }
+            ALWAYS_ASSERT(thrown == (threads > 1));
+        }
     }
-    // rotation 
-    // shearing
-    // reflection
-    // orthogonal projection
+
+    // builders, at compile time where they can be
     {
+        std::cout << "Test 3: Builder test\n";
+
+        using T = int32_t;
+
+        constexpr auto scale = ScaleMatrix<T,3>(3);
+        static_assert(scale.Elements == Matrix<T,3,3>(3, 0, 0,
+                                                      0, 3, 0,
+                                                      0, 0, 3).Elements);
+        constexpr auto move = ComposeAffine(TranslationMatrix(Point<T,3>{ 1, 2, 3 }), AffineMatrix(ScaleMatrix(Point<T,3>{ 2, 3, 4 })));
+        static_assert(move.Elements == Matrix<T,4,4>(2, 0, 0, 1,
+                                                     0, 3, 0, 2,
+                                                     0, 0, 4, 3,
+                                                     0, 0, 0, 1).Elements);
+        constexpr auto quarterTurn = RotationMatrix(Point<T,3>{ 0, 0, 1 }, T(0), T(1));
+        static_assert(quarterTurn.Elements == Matrix<T,3,3>(0, -1, 0,
+                                                            1,  0, 0,
+                                                            0,  0, 1).Elements);
+
+        const auto v = UnitPoint<T,3>();
+        ALWAYS_ASSERT((Transform(scale, v) == 3 * v));
+        ALWAYS_ASSERT((Transform(move, Point<T,3>{ 1, 1, 1 }) == Point<T,3>{ 3, 5, 7 }));
+        ALWAYS_ASSERT((Transform(RotationMatrix(T(0), T(1)), Point<T,2>{ 1, 0 }) == Point<T,2>{ 0, 1 }));
+        ALWAYS_ASSERT((Transform(ShearMatrix<T,2>(0, 1, 2), Point<T,2>{ 1, 1 }) == Point<T,2>{ 3, 1 }));
+        ALWAYS_ASSERT((Transform(ReflectionMatrix(Point<T,3>{ 0, 1, 0 }), Point<T,3>{ 1, 2, 3 }) == Point<T,3>{ 1, -2, 3 }));
+
+        // a third of a turn about (1, 1, 1) takes x to y, y to z and z to x
+        using F = double;
+        const F pi = std::acos(F(-1));
+        const auto axis = Repeat<F,3>(1 / std::sqrt(F(3)));
+        const auto third = RotationMatrix(axis, 2 * pi / 3);
+        const auto turned = Transform(third, Point<F,3>{ 1, 2, 3 });
+        for (size_t d = 0; d < 3; ++d) ALWAYS_ASSERT(std::abs(turned[d] - F((d + 2) % 3 + 1)) <= 1e-12);
+        const auto planar = RotationMatrix(pi / 2);
+        ALWAYS_ASSERT(std::abs(planar[0]) <= 1e-12 && planar[1] == -1 && planar[2] == 1);
+    }
+
+    // sparse composition against the dense product
+    {
+        std::cout << "Test 4: Composition test\n";
+
+        using T = int32_t;
+        const size_t D = 3;
+        const size_t N = D + 1;
+
+        auto reng = GetRandomEngine();
+        for (size_t i = 0; i < 100; ++i)
+        {
+            auto a = RandomMatrix<T,N,N>(reng, -9, 9);
+            auto b = RandomMatrix<T,N,N>(reng, -9, 9);
+            for (size_t c = 0; c < N; ++c)
+            {
+                a[D*N+c] = c == D ? 1 : 0;
+                b[D*N+c] = c == D ? 1 : 0;
+            }
+            const auto linear = RandomMatrix<T,D,D>(reng, -9, 9);
+            const auto factors = RandomPoint<T,D>(reng, -9, 9);
+            const auto offset = RandomPoint<T,D>(reng, -9, 9);
+
+            ALWAYS_ASSERT(ComposeAffine(a, b) == a * b);
+            ALWAYS_ASSERT(Scaled(a, factors) == AffineMatrix(ScaleMatrix(factors)) * a);
+            ALWAYS_ASSERT(Scaled(linear, factors) == ScaleMatrix(factors) * linear);
+            ALWAYS_ASSERT(Translated(a, offset) == TranslationMatrix(offset) * a);
+            ALWAYS_ASSERT(AffineMatrix(linear, offset) == TranslationMatrix(offset) * AffineMatrix(linear));
+        }
+    }
+
+    // y = alpha * A * x + beta * y
+    {
+        std::cout << "Test 5: Matrix vector multiply add test\n";
+
+        using T = int32_t;
+
+        constexpr auto y = []
+        {
+            Point<T,2> y{ 1, 2 };
+            MultiplyAdd(y, Matrix<T,2,3>(1, 2, 3, 4, 5, 6), Point<T,3>{ 1, 0, -1 }, 2, -1);
+            return y;
+        }();
+        static_assert(y == Point<T,2>{ -5, -6 });
+
+        auto reng = GetRandomEngine();
+        for (size_t i = 0; i < 100; ++i)
+        {
+            const auto a = RandomMatrix<T,4,3>(reng, -9, 9);
+            const auto x = RandomPoint<T,3>(reng, -9, 9);
+            auto y0 = RandomPoint<T,4>(reng, -9, 9);
+            auto y1 = y0;
+            MultiplyAdd(y1, a, x, 3, -2);
+
+            const auto ax = a * Matrix<T,3,1>(x[0], x[1], x[2]);
+            for (size_t r = 0; r < 4; ++r)
+                ALWAYS_ASSERT(y1[r] == 3 * ax[r] - 2 * y0[r]);
+        }
     }
-}
\ No newline at end of file
+}
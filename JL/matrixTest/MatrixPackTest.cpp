@@ -0,0 +1,104 @@
+/*
+MatrixPackTest.cpp
+*/
+
+#include "JL/matrix/MatrixPack.h"
+#include "JL/matrix/RandomMatrix.h"
+
+#include "JL/utils/Utils.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace jl;
+
+void TestMatrixPack()
+{
+    std::cout << "##### Matrix Pack Test #####\n";
+
+    auto reng = GetRandomEngine();
+
+    // pack operations against the same operation on each matrix
+    {
+        std::cout << "Test 1: Pack operations test\n";
+
+        using T = int32_t;
+        const size_t N = 4;
+        const size_t L = 8;
+
+        std::vector<Matrix<T,N,N>> a(L), b(L);
+        for (auto& m : a) m = RandomMatrix<T,N,N>(reng, -9, 9);
+        for (auto& m : b) m = RandomMatrix<T,N,N>(reng, -9, 9);
+
+        const MatrixPack<T,N,L> pa(a.data()), pb(b.data());
+        const auto product = pa * pb;
+        const auto transposed = Transpose(pa);
+        const auto determinants = Determinant(pa);
+        for (size_t l = 0; l < L; ++l)
+        {
+            ALWAYS_ASSERT(pa[l] == a[l]);
+            ALWAYS_ASSERT(product[l] == a[l] * b[l]);
+            ALWAYS_ASSERT(determinants[l] == Determinant(a[l]));
+            for (size_t r = 0; r < N; ++r)
+                for (size_t c = 0; c < N; ++c)
+                    ALWAYS_ASSERT(transposed[l][c*N+r] == a[l][r*N+c]);
+        }
+
+        std::vector<Matrix<T,N,N>> out(L);
+        auto pc = pa;
+        pc.Set(3, b[3]);
+        pc.ToMatrices(out.data());
+        ALWAYS_ASSERT(out[3] == b[3] && out[4] == a[4]);
+    }
+
+    // batches with a tail after the last pack, against one matrix at a time
+    {
+        std::cout << "Test 2: Batch test\n";
+
+        using F = double;
+        auto testSize = [&](auto n)
+        {
+            constexpr size_t N = decltype(n)::value;
+            for (size_t count : { size_t(5), size_t(1000), size_t(4099) })
+            {
+                std::vector<Matrix<F,N,N>> a(count), b(count);
+                for (auto& m : a) m = RandomMatrix<F,N,N>(reng, -1, 1);
+                for (auto& m : b) m = RandomMatrix<F,N,N>(reng, -1, 1);
+
+                for (size_t threads : { 1, 4 })
+                {
+                    std::vector<Matrix<F,N,N>> out(count);
+                    Multiply(a.data(), b.data(), out.data(), count, threads);
+                    for (size_t i = 0; i < count; ++i)
+                        for (size_t k = 0; k < N*N; ++k)
+                            ALWAYS_ASSERT(std::abs(out[i][k] - (a[i] * b[i])[k]) <= 1e-12);
+
+                    out = a;
+                    Transpose(out.data(), out.data(), count, threads);
+                    for (size_t i = 0; i < count; ++i)
+                        for (size_t r = 0; r < N; ++r)
+                            for (size_t c = 0; c < N; ++c)
+                                ALWAYS_ASSERT(out[i][c*N+r] == a[i][r*N+c]);
+
+                    std::vector<F> determinants(count);
+                    Determinant(a.data(), determinants.data(), count, threads);
+                    for (size_t i = 0; i < count; ++i)
+                        ALWAYS_ASSERT(determinants[i] == Determinant(a[i]));
+
+                    out = a;
+                    InverseMatrix(out.data(), count, threads);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        auto expected = a[i];
+                        InverseMatrix(expected);
+                        ALWAYS_ASSERT(out[i] == expected);
+                    }
+                }
+            }
+        };
+        testSize(std::integral_constant<size_t, 2>());
+        testSize(std::integral_constant<size_t, 3>());
+        testSize(std::integral_constant<size_t, 4>());
+    }
+}
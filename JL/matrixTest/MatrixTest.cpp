@@ -5,7 +5,10 @@ MatrixTest.cpp
 #include "JL/matrix/Matrix.h"
 #include "JL/matrix/RandomMatrix.h"
 
+#include <cmath>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 
 void TestMatrix()
@@ -97,25 +100,50 @@ void TestMatrix()
                 ALWAYS_ASSERT(a.NumRows() == b.NumColumns());
                 ALWAYS_ASSERT(a == c);
             }
+            // T(a)(n, m) = a(m, n)
+            {
+                const size_t M = 2, N = 3;
+
+                auto a = RandomMatrix<T,M,N>(reng, min, max);
+                auto b = Transpose(a);
+                for (size_t m = 0; m < M; ++m)
+                    for (size_t n = 0; n < N; ++n)
+                        ALWAYS_ASSERT(b[n*M+m] == a[m*N+n]);
+            }
             // T(a + b) =  T(a) + T(b)
             {
                 auto a = RandomMatrix<T,M,N>(reng, min, max);
                 auto b = RandomMatrix<T,M,N>(reng, min, max);
-                ALWAYS_ASSERT((a + b) == (Transpose(a) + Transpose(b)));
+                ALWAYS_ASSERT(Transpose(a + b) == (Transpose(a) + Transpose(b)));
             }
             // T(AB) = T(b)T(a)
             {
                 auto a = RandomMatrix<T,M,N>(reng, min, max);
                 auto b = RandomMatrix<T,M,N>(reng, min, max);
-                ALWAYS_ASSERT((a * b) == (Transpose(a) * Transpose(b)));
+                ALWAYS_ASSERT(Transpose(a * b) == (Transpose(b) * Transpose(a)));
             }
             // T(cA) = cT(a)
             {
                 auto a = RandomMatrix<T,M,N>(reng, min, max);
                 T s = rnInt32(reng);
-                ALWAYS_ASSERT((s * a) == (s * Transpose(a)));
+                ALWAYS_ASSERT(Transpose(s * a) == (s * Transpose(a)));
             }
         }
+
+        // blocked, with partial blocks, and in place
+        auto a = std::make_unique<Matrix<T,70,45>>(RandomMatrix<T,70,45>(reng, min, max));
+        auto t = std::make_unique<Matrix<T,45,70>>(Transpose(*a));
+        for (size_t m = 0; m < 70; ++m)
+            for (size_t n = 0; n < 45; ++n)
+                ALWAYS_ASSERT((*t)[n*70+m] == (*a)[m*45+n]);
+        ALWAYS_ASSERT(Transpose(*t) == *a);
+
+        auto square = std::make_unique<Matrix<T,67,67>>(RandomMatrix<T,67,67>(reng, min, max));
+        auto inPlace = std::make_unique<Matrix<T,67,67>>(*square);
+        TransposeInPlace(*inPlace);
+        ALWAYS_ASSERT(*inPlace == Transpose(*square));
+        static_assert([] { auto b = Matrix<int,2,2>(1, 2, 3, 4); return TransposeInPlace(b); }() == Matrix<int,2,2>(1, 3, 2, 4));
+        static_assert(Transpose(Matrix<int,2,3>(1, 2, 3, 4, 5, 6)) == Matrix<int,3,2>(1, 4, 2, 5, 3, 6));
     }
 
     // Matrix multiplication
@@ -194,11 +222,402 @@ void TestMatrix()
         5. det(cA) = c^n det(A) for an n x n matrix, A.
         */
         {
-            const size_t M=3, N=3;
+            ALWAYS_ASSERT(Determinant(IdentityMatrix<T,3,3>()) == 1);
+            ALWAYS_ASSERT(Determinant(IdentityMatrix<T,4,4>()) == 1);
+            ALWAYS_ASSERT(Determinant(IdentityMatrix<T,7,7>()) == 1);
+
+            Matrix<T,3,3> a{ 2, -3, 1, 2, 0, -1, 1, 4, 5 };
+            ALWAYS_ASSERT(Determinant(a) == 49);
+        }
+        for (size_t i = 0; i < 100; ++i)
+        {
+            // closed forms and Bareiss elimination against the cofactor expansion
+            {
+                auto a = RandomMatrix<T,2,2>(reng, min, max);
+                ALWAYS_ASSERT(Determinant(a) == detail::DeterminantCofactor(a));
+            }
+            {
+                auto a = RandomMatrix<T,3,3>(reng, min, max);
+                auto b = RandomMatrix<T,3,3>(reng, min, max);
+                ALWAYS_ASSERT(Determinant(a) == detail::DeterminantCofactor(a));
+                ALWAYS_ASSERT(Determinant(Transpose(a)) == Determinant(a));
+                ALWAYS_ASSERT(Determinant(a * b) == Determinant(a) * Determinant(b));
+            }
+            {
+                auto a = RandomMatrix<T,4,4>(reng, min, max);
+                auto b = RandomMatrix<T,4,4>(reng, min, max);
+                ALWAYS_ASSERT(Determinant(a) == detail::DeterminantCofactor(a));
+                ALWAYS_ASSERT(Determinant(a * b) == Determinant(a) * Determinant(b));
+            }
+            {
+                const size_t M = 6;
+                auto a = RandomMatrix<T,M,M>(reng, min, max);
+                ALWAYS_ASSERT(Determinant(a) == detail::DeterminantCofactor(a));
+
+                // det(cA) = c^n det(A)
+                T s = rnInt32(reng) % 3;
+                ALWAYS_ASSERT(Determinant(s * a) == s*s*s*s*s*s * Determinant(a));
+            }
+            // LU decomposition for floating point matrices
+            {
+                using F = double;
+                const size_t M = 7;
+                auto a = RandomMatrix<F,M,M>(reng, -10.0, 10.0);
+                auto b = RandomMatrix<F,M,M>(reng, -10.0, 10.0);
+
+                const F d = Determinant(a);
+                const F expected = detail::DeterminantCofactor(a);
+                ALWAYS_ASSERT(std::abs(d - expected) <= 1e-9 * std::abs(expected));
+
+                const F dab = Determinant(a * b);
+                const F dadb = Determinant(a) * Determinant(b);
+                ALWAYS_ASSERT(std::abs(dab - dadb) <= 1e-9 * std::abs(dadb));
+            }
+        }
+    }
+
+    // Blocked matrix multiplication
+    {
+        std::cout << "Test 7: Blocked matrix multiplication test\n";
+
+        // odd sizes so that every edge case of the MR x NR register block and the KC depth block is hit
+        const size_t sizes[][3] = { {1,1,1}, {3,5,7}, {17,9,13}, {65,300,33}, {130,257,70} };
+        for (auto& s : sizes)
+        {
+            const size_t M = s[0], N = s[1], P = s[2];
+
+            std::vector<T> a(M*N), b(N*P), c1(M*P), c2(M*P, T(7));
+            for (auto& v : a) v = rnInt32(reng);
+            for (auto& v : b) v = rnInt32(reng);
+
+            detail::GemmNaive(M, N, P, a.data(), N, b.data(), P, c1.data(), P);
+            detail::GemmBlocked(M, N, P, a.data(), N, b.data(), P, c2.data(), P);
+            ALWAYS_ASSERT(c1 == c2);
+
+            std::vector<double> ad(a.begin(), a.end()), bd(b.begin(), b.end()), cd1(M*P), cd2(M*P);
+            for (auto& v : ad) v *= 0.37;
+            for (auto& v : bd) v *= 1.13;
+
+            detail::GemmNaive(M, N, P, ad.data(), N, bd.data(), P, cd1.data(), P);
+            detail::GemmBlocked(M, N, P, ad.data(), N, bd.data(), P, cd2.data(), P);
+            for (size_t i = 0; i < M*P; ++i)
+                ALWAYS_ASSERT(std::abs(cd1[i] - cd2[i]) <= 1e-12 * N * 100);
+
+            // c + a * b adds c after the sum, like GemmNaive, within one KC panel
+            for (size_t i = 0; i < M*P; ++i) cd2[i] = cd1[i] = 0.71 * i;
+            detail::GemmNaive(M, N, P, 1.0, ad.data(), N, bd.data(), P, 1.0, cd1.data(), P);
+            detail::GemmBlocked(M, N, P, 1.0, ad.data(), N, bd.data(), P, 1.0, cd2.data(), P);
+            for (size_t i = 0; i < M*P; ++i)
+                ALWAYS_ASSERT(N <= detail::GemmBlocking<double>::KC ? cd1[i] == cd2[i] : std::abs(cd1[i] - cd2[i]) <= 1e-12 * N * 100);
+        }
+
+        // a single column of b and c with a row stride is not taken for a contiguous vector
+        {
+            const size_t M = 50, N = 40;
+            std::vector<T> a(M*N), b(N*3), c(M*3, T(1)), expected(M*3, T(1));
+            for (auto& v : a) v = rnInt32(reng);
+            for (auto& v : b) v = rnInt32(reng);
+
+            detail::GemmNaive(M, N, size_t(1), T(2), a.data(), N, b.data(), 3, T(-1), expected.data(), 3);
+            detail::Gemm(M, N, size_t(1), T(2), a.data(), N, b.data(), 3, T(-1), c.data(), 3);
+            ALWAYS_ASSERT(c == expected);
+        }
+
+        // operator* picks the blocked kernel for large compile time sizes
+        {
+            const size_t M = 40, N = 35, P = 33;
+            static_assert(M*N*P >= detail::GemmBlockedThreshold, "expected the blocked path");
+
+            auto a = std::make_unique<Matrix<T,M,N>>(RandomMatrix<T,M,N>(reng, min, max));
+            auto b = std::make_unique<Matrix<T,N,P>>(RandomMatrix<T,N,P>(reng, min, max));
+            auto c = std::make_unique<Matrix<T,M,P>>(*a * *b);
+
+            Matrix<T,M,P> expected;
+            detail::GemmNaive(M, N, P, a->Elements.data(), N, b->Elements.data(), P, expected.Elements.data(), P);
+            ALWAYS_ASSERT(*c == expected);
+        }
+    }
+
+    // Vectorised elementwise operators
+    {
+        std::cout << "Test 8: Vectorised elementwise test\n";
+
+        const size_t M = 9, N = 7;
+        static_assert(simd::UseKernels<T, M*N>, "expected the vectorised path");
+
+        const auto detected = simd::DetectSimdLevel();
+        for (int level = 0; level <= static_cast<int>(detected); ++level)
+        {
+            simd::SetSimdLevel(static_cast<simd::SimdLevel>(level));
+
+            auto a = RandomMatrix<T,M,N>(reng, min, max);
+            auto b = RandomMatrix<T,M,N>(reng, min, max);
+            T s = rnInt32(reng);
+            if (s == 0) ++s;
+
+            auto sum = a + b;
+            auto difference = a - b;
+            auto scaled = a * s;
+            auto divided = a / s;
+            for (size_t i = 0; i < M*N; ++i)
+            {
+                ALWAYS_ASSERT(sum[i] == a[i] + b[i]);
+                ALWAYS_ASSERT(difference[i] == a[i] - b[i]);
+                ALWAYS_ASSERT(scaled[i] == a[i] * s);
+                ALWAYS_ASSERT(divided[i] == a[i] / s);
+            }
+
+            using F = double;
+            auto c = RandomMatrix<F,M,N>(reng, -10.0, 10.0);
+            auto d = c;
+            d /= F(3);
+            for (size_t i = 0; i < M*N; ++i) ALWAYS_ASSERT(d[i] == c[i] / F(3));
+            d *= F(3);
+            d -= c;
+            d += c;
+            for (size_t i = 0; i < M*N; ++i) ALWAYS_ASSERT(d[i] == ((c[i] / F(3)) * F(3) - c[i]) + c[i]);
+        }
+        simd::SetSimdLevel(detected);
+    }
+
+    // Inverse
+    {
+        std::cout << "Test 9: Inverse matrix test\n";
+
+        using F = double;
+        const F tolerance = 1e-9;
+
+        auto isIdentity = [&](const auto& a)
+        {
+            const size_t N = a.NumRows();
+            for (size_t r = 0; r < N; ++r)
+                for (size_t c = 0; c < N; ++c)
+                    if (std::abs(a[r*N+c] - (r == c ? F(1) : F(0))) > tolerance) return false;
+            return true;
+        };
+
+        auto testSize = [&](auto tag)
+        {
+            constexpr size_t N = decltype(tag)::value;
+            for (size_t i = 0; i < 100; ++i)
+            {
+                auto a = RandomMatrix<F,N,N>(reng, -10.0, 10.0);
+                if (std::abs(Determinant(a)) < 1e-3) continue;
+
+                auto inverse = a;
+                InverseMatrix(inverse);
+                ALWAYS_ASSERT(isIdentity(a * inverse));
+                ALWAYS_ASSERT(isIdentity(inverse * a));
+
+                // det(Inv(A)) = 1/det(A)
+                ALWAYS_ASSERT(std::abs(Determinant(inverse) * Determinant(a) - F(1)) <= tolerance);
+            }
+
+            // batched, with a remainder that does not fill a whole batch
+            std::vector<Matrix<F,N,N>> batch;
+            while (batch.size() < 2 * detail::InverseBatchLanes + 3)
+            {
+                auto a = RandomMatrix<F,N,N>(reng, -10.0, 10.0);
+                if (std::abs(Determinant(a)) >= 1e-3) batch.push_back(a);
+            }
+            auto inverses = batch;
+            InverseMatrix(inverses.data(), inverses.size());
+            for (size_t i = 0; i < batch.size(); ++i)
+            {
+                auto expected = batch[i];
+                InverseMatrix(expected);
+                for (size_t k = 0; k < N*N; ++k)
+                    ALWAYS_ASSERT(std::abs(inverses[i][k] - expected[k]) <= tolerance * (1 + std::abs(expected[k])));
+            }
+        };
+        testSize(std::integral_constant<size_t, 1>());
+        testSize(std::integral_constant<size_t, 2>());
+        testSize(std::integral_constant<size_t, 3>());
+        testSize(std::integral_constant<size_t, 4>());
+        testSize(std::integral_constant<size_t, 5>());
+        testSize(std::integral_constant<size_t, 8>());
+
+        Matrix<F,2,2> a{ 4.0, 3.0, 3.0, 2.5 };
+        ALWAYS_ASSERT(InverseMatrix(a) == (Matrix<F,2,2>{ 2.5, -3.0, -3.0, 4.0 }));
+    }
+
+    // Lazy expressions
+    {
+        std::cout << "Test 10: Lazy expression test\n";
+
+        // large enough that the eager operators take the vectorised path, the fused loop has to agree
+        const size_t M = 9, N = 7;
+        for (size_t i = 0; i < 100; ++i)
+        {
             auto a = RandomMatrix<T,M,N>(reng, min, max);
+            auto b = RandomMatrix<T,M,N>(reng, min, max);
+            auto c = RandomMatrix<T,M,N>(reng, min, max);
+            T s = rnInt32(reng);
+            if (s == 0) ++s;
+
+            // c * s alone is the eager operator, Lazy(c) * s is part of the fused loop
+            static_assert(!expr::IsExpression<decltype(c * s)> && expr::IsExpression<decltype(Lazy(c) * s)>);
+            Matrix<T,M,N> r = Evaluate(Lazy(a) + b - Lazy(c) * s);
+            ALWAYS_ASSERT(r == a + b - c * s);
+            ALWAYS_ASSERT(Evaluate(a - (Lazy(b) + c) / s) == a - (b + c) / s);
+            ALWAYS_ASSERT((Evaluate(-Lazy(a) + a) == Matrix<T,M,N>()));
+
+            auto expected = s * a - b;
+            Assign(a, s * Lazy(a) - b);
+            ALWAYS_ASSERT(a == expected);
+        }
+    }
+
+    // constexpr
+    {
+        std::cout << "Test 11: Compile time test\n";
+
+        using I = int32_t;
+        constexpr auto identity = IdentityMatrix<I,3,3>();
+        constexpr Matrix<I,3,3> a(2, 0, 1,
+                                  1, 3, 2,
+                                  1, 1, 2);
+        static_assert(a * identity == a);
+        static_assert((a + a - a) * 2 / 2 == a);
+        static_assert(Determinant(a) == 6);
+        static_assert(Determinant(DiagonalMatrix<I,4,4>(2)) == 16);
+        static_assert(Submatrix(a, 0, 0) == Matrix<I,2,2>(3, 2, 1, 2));
+        static_assert(IsDiagonalMatrix(DiagonalMatrix<I,3,3>(5)) && !IsDiagonalMatrix(a));
+        static_assert(Transpose(identity) == identity);
+
+        // large enough that the same calls take the Simd.h kernels and the blocked product at run time
+        constexpr auto twice = DiagonalMatrix<float,32,32>(2.0f);
+        static_assert(twice * twice == DiagonalMatrix<float,32,32>(4.0f));
+        static_assert(twice + twice == twice * 2.0f);
+        auto runtime = twice;
+        ALWAYS_ASSERT(runtime * runtime == (DiagonalMatrix<float,32,32>(4.0f)));
+        ALWAYS_ASSERT(runtime + runtime == (DiagonalMatrix<float,32,32>(4.0f)));
+    }
+
+    // Unrolled small products
+    {
+        std::cout << "Test 12: Small matrix multiplication test\n";
+
+        // every size up to 4 x 4 x 4, including the SSE / AVX paths for 4 columns
+        auto testSize = [&](auto m, auto n, auto p)
+        {
+            constexpr size_t M = decltype(m)::value + 1;
+            constexpr size_t N = decltype(n)::value + 1;
+            constexpr size_t P = decltype(p)::value + 1;
+
+            const auto a = RandomMatrix<T,M,N>(reng, min, max);
+            const auto b = RandomMatrix<T,N,P>(reng, min, max);
+            Matrix<T,M,P> expected;
+            detail::GemmNaive(M, N, P, a.Elements.data(), N, b.Elements.data(), P, expected.Elements.data(), P);
+            ALWAYS_ASSERT(a * b == expected);
+
+            auto testFloat = [&](auto zero)
+            {
+                using F = decltype(zero);
+                const auto af = RandomMatrix<F,M,N>(reng, F(-1), F(1));
+                const auto bf = RandomMatrix<F,N,P>(reng, F(-1), F(1));
+                Matrix<F,M,P> naive;
+                detail::GemmNaive(M, N, P, af.Elements.data(), N, bf.Elements.data(), P, naive.Elements.data(), P);
+                const auto c = af * bf;
+                for (size_t i = 0; i < M*P; ++i)
+                    ALWAYS_ASSERT(std::abs(c[i] - naive[i]) <= F(1e-5) * N);
+            };
+            testFloat(0.0f);
+            testFloat(0.0);
+        };
+        for (size_t i = 0; i < 10; ++i)
+            detail::Unroll<4>([&](auto m) { detail::Unroll<4>([&](auto n) { detail::Unroll<4>([&](auto p) { testSize(m, n, p); }); }); });
+    }
+    // Multithreaded products
+    {
+        std::cout << "Test 13: Parallel matrix multiplication test\n";
+
+        // past detail::GemmParallelThreshold, with partial tiles on both sides
+        auto a = std::make_unique<Matrix<T,130,140>>(RandomMatrix<T,130,140>(reng, min, max));
+        auto b = std::make_unique<Matrix<T,140,300>>(RandomMatrix<T,140,300>(reng, min, max));
+        auto expected = std::make_unique<Matrix<T,130,300>>();
+        detail::GemmNaive(size_t(130), size_t(140), size_t(300), a->Elements.data(), 140, b->Elements.data(), 300, expected->Elements.data(), 300);
 
-            //T d = Determinant(a);
+        auto c = std::make_unique<Matrix<T,130,300>>();
+        for (size_t threads : { 0, 1, 2, 3 })
+        {
+            *c = ParallelMultiply(*a, *b, threads);
+            ALWAYS_ASSERT(*c == *expected);
         }
 
+        // below the threshold it is operator*
+        const auto small1 = RandomMatrix<T,3,4>(reng, min, max);
+        const auto small2 = RandomMatrix<T,4,4>(reng, min, max);
+        ALWAYS_ASSERT(ParallelMultiply(small1, small2, 4) == small1 * small2);
+    }
+
+    // In place c = alpha * a * b + beta * c
+    {
+        std::cout << "Test 14: Multiply add test\n";
+
+        // unrolled, naive, matrix vector, blocked and several KC panels of the blocked kernel
+        auto testSize = [&](auto m, auto n, auto p)
+        {
+            constexpr size_t M = decltype(m)::value;
+            constexpr size_t N = decltype(n)::value;
+            constexpr size_t P = decltype(p)::value;
+
+            auto a = std::make_unique<Matrix<T,M,N>>(RandomMatrix<T,M,N>(reng, min, max));
+            auto b = std::make_unique<Matrix<T,N,P>>(RandomMatrix<T,N,P>(reng, min, max));
+            auto c = std::make_unique<Matrix<T,M,P>>(RandomMatrix<T,M,P>(reng, min, max));
+            auto expected = std::make_unique<Matrix<T,M,P>>(*c + *a * *b);
+            MultiplyAdd(*c, *a, *b);
+            ALWAYS_ASSERT(*c == *expected);
+
+            *expected = *a * *b * 2 - *c * 3;
+            MultiplyAdd(*c, *a, *b, 2, -3, 2);
+            ALWAYS_ASSERT(*c == *expected);
+
+            // beta 0 overwrites c
+            *expected = *a * *b * -1;
+            MultiplyAdd(*c, *a, *b, -1, 0);
+            ALWAYS_ASSERT(*c == *expected);
+        };
+        using std::integral_constant;
+        testSize(integral_constant<size_t,3>(), integral_constant<size_t,4>(), integral_constant<size_t,2>());
+        testSize(integral_constant<size_t,10>(), integral_constant<size_t,12>(), integral_constant<size_t,9>());
+        testSize(integral_constant<size_t,20>(), integral_constant<size_t,30>(), integral_constant<size_t,1>());
+        testSize(integral_constant<size_t,40>(), integral_constant<size_t,50>(), integral_constant<size_t,60>());
+        testSize(integral_constant<size_t,37>(), integral_constant<size_t,600>(), integral_constant<size_t,43>());
+        testSize(integral_constant<size_t,130>(), integral_constant<size_t,140>(), integral_constant<size_t,150>());
+
+        // beta 0 does not read c, so NaN in c does not propagate
+        const auto a = RandomMatrix<double,40,40>(reng, -1.0, 1.0);
+        auto c = DiagonalMatrix<double,40,40>(std::nan(""));
+        MultiplyAdd(c, a, a, 1.0, 0.0);
+        ALWAYS_ASSERT(c == a * a);
+    }
+
+    // Products with a transposed operand
+    {
+        std::cout << "Test 15: Transposed view test\n";
+
+        // unrolled, naive and blocked sizes
+        auto testSize = [&](auto m, auto n, auto p)
+        {
+            constexpr size_t M = decltype(m)::value;
+            constexpr size_t N = decltype(n)::value;
+            constexpr size_t P = decltype(p)::value;
+
+            auto a = std::make_unique<Matrix<T,M,N>>(RandomMatrix<T,M,N>(reng, min, max));
+            auto b = std::make_unique<Matrix<T,M,P>>(RandomMatrix<T,M,P>(reng, min, max));
+            auto c = std::make_unique<Matrix<T,P,N>>(RandomMatrix<T,P,N>(reng, min, max));
+            ALWAYS_ASSERT(Transposed(*a) * *b == Transpose(*a) * *b);
+            ALWAYS_ASSERT(*a * Transposed(*c) == *a * Transpose(*c));
+            ALWAYS_ASSERT(Transposed(*a) * *a == Transpose(*a) * *a);
+        };
+        using std::integral_constant;
+        testSize(integral_constant<size_t,3>(), integral_constant<size_t,4>(), integral_constant<size_t,2>());
+        testSize(integral_constant<size_t,7>(), integral_constant<size_t,5>(), integral_constant<size_t,9>());
+        testSize(integral_constant<size_t,70>(), integral_constant<size_t,45>(), integral_constant<size_t,33>());
+
+        constexpr auto a = Matrix<int,2,3>(1, 2, 3, 4, 5, 6);
+        static_assert(Transposed(a) * a == Transpose(a) * a);
+        static_assert(a * Transposed(a) == a * Transpose(a));
     }
-}
\ No newline at end of file
+}
@@ -5,12 +5,18 @@ main.cpp
 #include <iostream>
 
 void TestMatrix();
+void TestDynamicMatrix();
 void TestTransformation();
+void TestMatrixPack();
+void TestLUDecomposition();
 
 int main()
 {
     TestMatrix();
-    //TestTransformation();
+    TestDynamicMatrix();
+    TestLUDecomposition();
+    TestTransformation();
+    TestMatrixPack();
 
     return 0;
 }
\ No newline at end of file
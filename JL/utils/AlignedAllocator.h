@@ -0,0 +1,49 @@
+/*
+AlignedAllocator.h
+
+Standard allocator returning storage aligned to `Alignment` bytes (a cache line by default, which is
+also the widest vector register). Use it with standard containers, e.g.
+    std::vector<float, AlignedAllocator<float>>
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace jl
+{
+    constexpr size_t CacheLineSize = 64;
+
+    template<typename T, size_t Alignment = CacheLineSize>
+    struct AlignedAllocator
+    {
+        static_assert(Alignment >= alignof(T), "Alignment must satisfy the alignment of T");
+        static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+        using value_type = T;
+
+        template<typename U>
+        struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+        AlignedAllocator() noexcept = default;
+        template<typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+        T* allocate(size_t n)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+        }
+
+        void deallocate(T* p, size_t) noexcept
+        {
+            ::operator delete(p, std::align_val_t(Alignment));
+        }
+    };
+
+    template<typename T, typename U, size_t Alignment>
+    bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) { return true; }
+
+    template<typename T, typename U, size_t Alignment>
+    bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) { return false; }
+
+} // namespace jl
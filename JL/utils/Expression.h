@@ -0,0 +1,186 @@
+/*
+Expression.h
+
+Opt-in expression templates for elementwise arithmetic on fixed-size containers (Matrix, Point).
+
+The ordinary operators return by value, so `a + b - c * s` writes two full temporaries before the
+result. Wrapping an operand in Lazy() makes the operators applied to it build a small expression object
+instead. Evaluate() or Assign() then runs the whole chain as one loop, reading each operand once and
+writing the result once:
+
+    auto r = Evaluate(Lazy(a) + b - Lazy(c) * s);   // r has the type of a
+    Assign(r, Lazy(r) * s + a);                     // in place, r may appear in its own expression
+
+Supported operators are +, - (container with container), unary - and * / with a scalar. These are the
+elementwise operators that Matrix and Point share. Matrix * Matrix stays a matrix product and is not
+an expression. Operands of a binary operator must have the same container type (the same size), so a
+size mismatch fails to compile like the eager operators do.
+
+An operator only becomes lazy when one of its operands is an expression. A container times a scalar is the
+eager operator even inside a lazy chain, `Lazy(a) + b - c * s` writes c * s to a temporary first, so every
+operand that is multiplied or divided by a scalar has to be Lazy() itself.
+
+Expressions hold references to their operands. Evaluate them in the statement that builds them and
+do not store them (e.g. in `auto`) beyond the lifetime of any operand.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace jl
+{
+    namespace expr
+    {
+        struct ExpressionBase {};
+
+        template<typename E> constexpr bool IsExpression = std::is_base_of_v<ExpressionBase, E>;
+
+        // A container operand
+        template<typename C>
+        struct Terminal : ExpressionBase
+        {
+            using Result = C;
+            using Scalar = std::decay_t<decltype(std::declval<const C&>()[0])>;
+
+            explicit Terminal(const C& c) : Container(c) {}
+
+            size_t size() const { return Container.size(); }
+            Scalar operator[](size_t i) const { return Container[i]; }
+
+            const C& Container;
+        };
+
+        template<typename Op, typename L, typename R>
+        struct Binary : ExpressionBase
+        {
+            static_assert(std::is_same_v<typename L::Result, typename R::Result>, "operands must have the same type and size");
+            using Result = typename L::Result;
+            using Scalar = typename L::Scalar;
+
+            Binary(const L& lhs, const R& rhs) : Lhs(lhs), Rhs(rhs) {}
+
+            size_t size() const { return Lhs.size(); }
+            Scalar operator[](size_t i) const { return Op::Apply(Lhs[i], Rhs[i]); }
+
+            L Lhs;
+            R Rhs;
+        };
+
+        template<typename Op, typename E>
+        struct WithScalar : ExpressionBase
+        {
+            using Result = typename E::Result;
+            using Scalar = typename E::Scalar;
+
+            WithScalar(const E& e, Scalar s) : Expr(e), S(s) {}
+
+            size_t size() const { return Expr.size(); }
+            Scalar operator[](size_t i) const { return Op::Apply(Expr[i], S); }
+
+            E Expr;
+            Scalar S;
+        };
+
+        template<typename E>
+        struct Negate : ExpressionBase
+        {
+            using Result = typename E::Result;
+            using Scalar = typename E::Scalar;
+
+            explicit Negate(const E& e) : Expr(e) {}
+
+            size_t size() const { return Expr.size(); }
+            Scalar operator[](size_t i) const { return -Expr[i]; }
+
+            E Expr;
+        };
+
+        struct AddOp      { template<typename T> static T Apply(T a, T b) { return a + b; } };
+        struct SubtractOp { template<typename T> static T Apply(T a, T b) { return a - b; } };
+        struct MultiplyOp { template<typename T> static T Apply(T a, T b) { return a * b; } };
+        struct DivideOp   { template<typename T> static T Apply(T a, T b) { return a / b; } };
+
+        // Expressions pass through, containers become terminals
+        template<typename X>
+        auto AsExpression(const X& x)
+        {
+            if constexpr (IsExpression<X>) return x;
+            else return Terminal<X>(x);
+        }
+
+        template<typename X> using ExpressionOf = decltype(AsExpression(std::declval<const X&>()));
+
+        // At least one side has to be an expression already, plain containers keep their eager operators
+        template<typename L, typename R>
+        using EnableIfAnyExpression = std::enable_if_t<IsExpression<L> || IsExpression<R>, int>;
+
+        template<typename L, typename R, EnableIfAnyExpression<L,R> = 0>
+        auto operator+(const L& lhs, const R& rhs)
+        {
+            return Binary<AddOp, ExpressionOf<L>, ExpressionOf<R>>(AsExpression(lhs), AsExpression(rhs));
+        }
+
+        template<typename L, typename R, EnableIfAnyExpression<L,R> = 0>
+        auto operator-(const L& lhs, const R& rhs)
+        {
+            return Binary<SubtractOp, ExpressionOf<L>, ExpressionOf<R>>(AsExpression(lhs), AsExpression(rhs));
+        }
+
+        template<typename E, std::enable_if_t<IsExpression<E>, int> = 0>
+        auto operator-(const E& e)
+        {
+            return Negate<E>(e);
+        }
+
+        template<typename E, std::enable_if_t<IsExpression<E>, int> = 0>
+        auto operator*(const E& e, typename E::Scalar s)
+        {
+            return WithScalar<MultiplyOp, E>(e, s);
+        }
+
+        template<typename E, std::enable_if_t<IsExpression<E>, int> = 0>
+        auto operator*(typename E::Scalar s, const E& e)
+        {
+            return WithScalar<MultiplyOp, E>(e, s);
+        }
+
+        template<typename E, std::enable_if_t<IsExpression<E>, int> = 0>
+        auto operator/(const E& e, typename E::Scalar s)
+        {
+            return WithScalar<DivideOp, E>(e, s);
+        }
+
+    } // namespace expr
+
+    // Starts a lazy expression, see above
+    template<typename C>
+    expr::Terminal<C> Lazy(const C& c)
+    {
+        return expr::Terminal<C>(c);
+    }
+
+    // Writes the expression into dst in one pass. Every element only depends on the same element of
+    // the operands, so dst may be one of them.
+    template<typename C, typename E>
+    C& Assign(C& dst, const E& e)
+    {
+        static_assert(expr::IsExpression<E>, "Assign expects a Lazy() expression");
+        static_assert(std::is_same_v<C, typename E::Result>, "destination must have the type of the expression");
+        const size_t n = e.size();
+        for (size_t i = 0; i < n; ++i)
+            dst[i] = e[i];
+        return dst;
+    }
+
+    template<typename E>
+    typename E::Result Evaluate(const E& e)
+    {
+        typename E::Result result{};
+        Assign(result, e);
+        return result;
+    }
+
+} // namespace jl
@@ -0,0 +1,53 @@
+/*
+MappedFile.h
+
+Read-only memory mapping of a whole file (mmap on POSIX, a file mapping object on Windows). The pages
+are loaded by the OS on first access and shared with the page cache, so opening a large file costs
+neither a read nor a copy.
+*/
+
+#pragma once
+
+#include "JL/utils/Utils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace jl
+{
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        // Throws std::runtime_error if the file cannot be opened or mapped
+        UTILS_API explicit MappedFile(const std::string& path);
+        UTILS_API ~MappedFile();
+
+        UTILS_API MappedFile(MappedFile&& other) noexcept;
+        UTILS_API MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const uint8_t* data() const { return Data; }
+        size_t size() const { return Size; }
+        bool is_open() const { return IsOpen; }
+
+        UTILS_API void Close();
+
+        // Releases the pages of [offset, offset + size) from memory, except a page that extends past the end. They
+        // stay mapped and are read from the file again if accessed, so this only lowers the memory use of a file
+        // that is read once front to back.
+        UTILS_API void Evict(size_t offset, size_t size);
+
+    private:
+        const uint8_t* Data = nullptr;
+        size_t Size = 0;
+        bool IsOpen = false;
+#ifdef _WIN32
+        void* FileHandle = nullptr;
+        void* MappingHandle = nullptr;
+#endif
+    };
+
+} // namespace jl
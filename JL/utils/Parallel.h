@@ -0,0 +1,43 @@
+/*
+Parallel.h
+
+ParallelFor splits [0, count) into contiguous ranges, one per thread, for loops whose iterations are independent:
+
+    ParallelFor(points.size(), numThreads, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i) ...
+    });
+
+Small counts stay on the calling thread, every thread gets at least minCountPerThread iterations. The ranges run
+on the workers of ThreadPool::Shared(), so a ParallelFor inside another one (or inside a pool task) is serial.
+If f throws, ranges that have not started are skipped and the first exception is rethrown once the running
+ones have finished.
+*/
+
+#pragma once
+
+#include "JL/utils/ThreadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+
+namespace jl
+{
+    // Calls f(begin, end) on up to numThreads ranges of [0, count), the calling thread takes the first range.
+    // numThreads 0 uses every hardware thread.
+    template<typename F>
+    void ParallelFor(size_t count, size_t numThreads, F&& f, size_t minCountPerThread = 4096)
+    {
+        if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+        const size_t threads = std::max<size_t>(1, std::min(numThreads, count / std::max<size_t>(1, minCountPerThread)));
+
+        if (threads == 1)
+        {
+            f(size_t(0), count);
+            return;
+        }
+        ThreadPool::Shared().Run(threads, threads, [&](size_t t) { f(count * t / threads, count * (t + 1) / threads); });
+    }
+
+} // namespace jl
@@ -0,0 +1,101 @@
+/*
+Simd.h
+
+Elementwise kernels over contiguous arrays with runtime CPU dispatch.
+
+Every kernel exists as a portable scalar loop and as SSE4.1, AVX2 and AVX-512 versions on x86. The
+first call detects the best instruction set the CPU (and OS) supports and every later call is routed
+to it. Kernels are defined for float, double and int32_t:
+    Add         out[i] = a[i] + b[i]
+    Subtract    out[i] = a[i] - b[i]
+    Multiply    out[i] = a[i] * b[i]
+    Scale       out[i] = a[i] * s
+    Divide      out[i] = a[i] / s       (int32_t always takes the scalar loop, there is no vector integer division)
+    Divide      out[i] = a[i] / b[i]    (floating point only)
+    AddScalar   out[i] = a[i] + s
+    ScaleAdd    out[i] = a[i] * s + b[i]
+    MultiplyAdd out[i] = a[i] * b[i] + c[i]
+    Sqrt        out[i] = sqrt(a[i])     (floating point only)
+    Dot         sum(a[i] * b[i])        (floating point sums are reassociated across lanes)
+
+`out` may alias any input, so the kernels also serve the compound assignment operators.
+
+Rounding: every product and sum rounds on its own, Simd.cpp is compiled without FMA contraction (see the utils
+CMakeLists.txt), so all kernels but Dot give the scalar loop's result bit for bit at every level. Dot sums
+in a different order per level, its floating point result may differ from the scalar loop in the last bits.
+*/
+
+#pragma once
+
+#include "JL/utils/Utils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace jl
+{
+    namespace simd
+    {
+        enum class SimdLevel { Scalar, SSE41, AVX2, AVX512 };
+
+        UTILS_API SimdLevel DetectSimdLevel();
+        UTILS_API SimdLevel GetSimdLevel();
+        // Forces a lower level (e.g. for testing or benchmarking), clamped to what the CPU supports
+        UTILS_API void SetSimdLevel(SimdLevel level);
+        UTILS_API const char* ToString(SimdLevel level);
+
+        // Element types with vector kernels
+        template<typename T> constexpr bool IsSupported = std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, int32_t>;
+
+        // Below this many elements the call and dispatch overhead outweighs the vector throughput
+        constexpr size_t MinElements = 32;
+
+        // Fixed-size types (Matrix, Point) use the kernels when they are large enough to benefit
+        template<typename T, size_t Count> constexpr bool UseKernels = IsSupported<T> && Count >= MinElements;
+
+        UTILS_API void Add(const float* a, const float* b, float* out, size_t n);
+        UTILS_API void Add(const double* a, const double* b, double* out, size_t n);
+        UTILS_API void Add(const int32_t* a, const int32_t* b, int32_t* out, size_t n);
+
+        UTILS_API void Subtract(const float* a, const float* b, float* out, size_t n);
+        UTILS_API void Subtract(const double* a, const double* b, double* out, size_t n);
+        UTILS_API void Subtract(const int32_t* a, const int32_t* b, int32_t* out, size_t n);
+
+        UTILS_API void Multiply(const float* a, const float* b, float* out, size_t n);
+        UTILS_API void Multiply(const double* a, const double* b, double* out, size_t n);
+        UTILS_API void Multiply(const int32_t* a, const int32_t* b, int32_t* out, size_t n);
+
+        UTILS_API void Scale(const float* a, float s, float* out, size_t n);
+        UTILS_API void Scale(const double* a, double s, double* out, size_t n);
+        UTILS_API void Scale(const int32_t* a, int32_t s, int32_t* out, size_t n);
+
+        UTILS_API void Divide(const float* a, float s, float* out, size_t n);
+        UTILS_API void Divide(const double* a, double s, double* out, size_t n);
+        UTILS_API void Divide(const int32_t* a, int32_t s, int32_t* out, size_t n);
+
+        UTILS_API void Divide(const float* a, const float* b, float* out, size_t n);
+        UTILS_API void Divide(const double* a, const double* b, double* out, size_t n);
+
+        UTILS_API void AddScalar(const float* a, float s, float* out, size_t n);
+        UTILS_API void AddScalar(const double* a, double s, double* out, size_t n);
+        UTILS_API void AddScalar(const int32_t* a, int32_t s, int32_t* out, size_t n);
+
+        UTILS_API void ScaleAdd(const float* a, float s, const float* b, float* out, size_t n);
+        UTILS_API void ScaleAdd(const double* a, double s, const double* b, double* out, size_t n);
+        UTILS_API void ScaleAdd(const int32_t* a, int32_t s, const int32_t* b, int32_t* out, size_t n);
+
+        UTILS_API void MultiplyAdd(const float* a, const float* b, const float* c, float* out, size_t n);
+        UTILS_API void MultiplyAdd(const double* a, const double* b, const double* c, double* out, size_t n);
+        UTILS_API void MultiplyAdd(const int32_t* a, const int32_t* b, const int32_t* c, int32_t* out, size_t n);
+
+        UTILS_API void Sqrt(const float* a, float* out, size_t n);
+        UTILS_API void Sqrt(const double* a, double* out, size_t n);
+
+        UTILS_API float Dot(const float* a, const float* b, size_t n);
+        UTILS_API double Dot(const double* a, const double* b, size_t n);
+        UTILS_API int32_t Dot(const int32_t* a, const int32_t* b, size_t n);
+
+    } // namespace simd
+
+} // namespace jl
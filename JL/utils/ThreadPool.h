@@ -0,0 +1,73 @@
+/*
+ThreadPool.h
+
+Persistent worker threads that run a fixed set of tasks with work stealing, for parallel loops whose
+iterations have uneven cost or are too coarse to split evenly (e.g. the output tiles of a GEMM):
+
+    ThreadPool::Shared().Run(taskCount, numThreads, [&](size_t task) { ... });
+
+The tasks are dealt out in contiguous runs, one run per thread, so neighbouring tasks stay on the same
+thread. A thread that runs out takes tasks from the back of another thread's run. The calling thread
+takes part, and Run returns once every task has finished.
+
+Workers are started on first use and kept for later calls, so the pool grows to the largest numThreads
+it was asked for. A Run from inside a task runs serially on that thread. If a task throws, the tasks that have
+not started are skipped and Run rethrows the first exception once the running ones have finished.
+*/
+
+#pragma once
+
+#include "JL/utils/Utils.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jl
+{
+    class ThreadPool
+    {
+    public:
+        ThreadPool() = default;
+        UTILS_API ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // The pool shared by the library
+        UTILS_API static ThreadPool& Shared();
+
+        // Calls f(task) for every task in [0, taskCount) on up to numThreads threads, including the calling thread.
+        // numThreads 0 uses every hardware thread.
+        template<typename F>
+        void Run(size_t taskCount, size_t numThreads, F&& f)
+        {
+            const std::function<void(size_t)> task = std::forward<F>(f);
+            RunTasks(taskCount, numThreads, task);
+        }
+
+        // Worker threads started so far, not counting callers
+        UTILS_API size_t NumWorkers();
+
+    private:
+        struct Job;
+
+        UTILS_API void RunTasks(size_t taskCount, size_t numThreads, const std::function<void(size_t)>& f);
+        void WorkerLoop(size_t index);
+
+        std::mutex Mutex;               // guards everything below
+        std::condition_variable Wake;
+        std::vector<std::thread> Workers;
+        std::shared_ptr<Job> Current;
+        uint64_t Generation = 0;
+        bool Stop = false;
+
+        std::mutex RunMutex;            // one Run at a time
+    };
+
+} // namespace jl
@@ -0,0 +1,149 @@
+#include "JL/utils/MappedFile.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace jl
+{
+#ifdef _WIN32
+    UTILS_API MappedFile::MappedFile(const std::string& path)
+    {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("failed to open " + path);
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            throw std::runtime_error("failed to read the size of " + path);
+        }
+
+        FileHandle = file;
+        Size = static_cast<size_t>(size.QuadPart);
+        IsOpen = true;
+        if (Size == 0) return; // empty files cannot be mapped
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (view == nullptr)
+        {
+            if (mapping) CloseHandle(mapping);
+            Close();
+            throw std::runtime_error("failed to map " + path);
+        }
+        MappingHandle = mapping;
+        Data = static_cast<const uint8_t*>(view);
+    }
+
+    UTILS_API void MappedFile::Close()
+    {
+        if (Data) UnmapViewOfFile(Data);
+        if (MappingHandle) CloseHandle(MappingHandle);
+        if (FileHandle) CloseHandle(FileHandle);
+        Data = nullptr;
+        MappingHandle = FileHandle = nullptr;
+        Size = 0;
+        IsOpen = false;
+    }
+#else
+    UTILS_API MappedFile::MappedFile(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("failed to open " + path);
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("failed to read the size of " + path);
+        }
+
+        Size = static_cast<size_t>(st.st_size);
+        IsOpen = true;
+        if (Size > 0) // empty files cannot be mapped
+        {
+            void* view = ::mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("failed to map " + path);
+            }
+            ::madvise(view, Size, MADV_SEQUENTIAL);
+            Data = static_cast<const uint8_t*>(view);
+        }
+        // the mapping keeps its own reference to the file
+        ::close(fd);
+    }
+
+    UTILS_API void MappedFile::Close()
+    {
+        if (Data) ::munmap(const_cast<uint8_t*>(Data), Size);
+        Data = nullptr;
+        Size = 0;
+        IsOpen = false;
+    }
+#endif
+
+    UTILS_API void MappedFile::Evict(size_t offset, size_t size)
+    {
+        if (Data == nullptr || offset >= Size) return;
+        size = std::min(size, Size - offset);
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        const size_t page = info.dwPageSize;
+#else
+        const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+        // the page holding the end of the range may still be in use, the one holding its start is dropped too
+        const size_t begin = offset / page * page;
+        const size_t end = (offset + size) / page * page;
+        if (end <= begin) return;
+#ifdef _WIN32
+        // unlocking pages that are not locked removes them from the working set
+        VirtualUnlock(const_cast<uint8_t*>(Data) + begin, end - begin);
+#else
+        ::madvise(const_cast<uint8_t*>(Data) + begin, end - begin, MADV_DONTNEED);
+#endif
+    }
+
+    UTILS_API MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    UTILS_API MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    UTILS_API MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            std::swap(Data, other.Data);
+            std::swap(Size, other.Size);
+            std::swap(IsOpen, other.IsOpen);
+#ifdef _WIN32
+            std::swap(FileHandle, other.FileHandle);
+            std::swap(MappingHandle, other.MappingHandle);
+#endif
+        }
+        return *this;
+    }
+
+} // namespace jl
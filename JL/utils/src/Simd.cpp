@@ -0,0 +1,388 @@
+#include "JL/utils/Simd.h"
+
+#include <atomic>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define JL_SIMD_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#else
+    #define JL_SIMD_X86 0
+#endif
+
+// Every function defined between JL_TARGET_REGION and JL_END_TARGET_REGION (template instantiations
+// included) is compiled for the given instruction set. MSVC needs nothing, its intrinsics are always available.
+#define JL_PRAGMA(x) _Pragma(#x)
+#if defined(__clang__)
+    #define JL_TARGET_REGION(isa) JL_PRAGMA(clang attribute push(__attribute__((target(isa))), apply_to = function))
+    #define JL_END_TARGET_REGION JL_PRAGMA(clang attribute pop)
+#elif defined(__GNUC__)
+    #define JL_TARGET_REGION(isa) JL_PRAGMA(GCC push_options) JL_PRAGMA(GCC target(isa))
+    #define JL_END_TARGET_REGION JL_PRAGMA(GCC pop_options)
+#else
+    #define JL_TARGET_REGION(isa)
+    #define JL_END_TARGET_REGION
+#endif
+
+namespace jl
+{
+    namespace simd
+    {
+        namespace scalar
+        {
+            template<typename T>
+            void Add(const T* a, const T* b, T* out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = a[i] + b[i]; }
+
+            template<typename T>
+            void Subtract(const T* a, const T* b, T* out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = a[i] - b[i]; }
+
+            template<typename T>
+            void Multiply(const T* a, const T* b, T* out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = a[i] * b[i]; }
+
+            template<typename T>
+            void Scale(const T* a, T s, T* out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = a[i] * s; }
+
+            template<typename T>
+            void Divide(const T* a, T s, T* out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = a[i] / s; }
+
+            template<typename T>
+            void Divide(const T* a, const T* b, T* out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = a[i] / b[i]; }
+
+            template<typename T>
+            void AddScalar(const T* a, T s, T* out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = a[i] + s; }
+
+            template<typename T>
+            void ScaleAdd(const T* a, T s, const T* b, T* out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = a[i] * s + b[i]; }
+
+            template<typename T>
+            void MultiplyAdd(const T* a, const T* b, const T* c, T* out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = a[i] * b[i] + c[i]; }
+
+            template<typename T>
+            void Sqrt(const T* a, T* out, size_t n) { for (size_t i = 0; i < n; ++i) out[i] = std::sqrt(a[i]); }
+
+            template<typename T>
+            T Dot(const T* a, const T* b, size_t n)
+            {
+                T sum = 0;
+                for (size_t i = 0; i < n; ++i)
+                    sum += a[i] * b[i];
+                return sum;
+            }
+        } // namespace scalar
+
+#if JL_SIMD_X86
+
+JL_TARGET_REGION("sse4.1")
+        namespace sse41
+        {
+            template<typename T> struct Vec;
+
+            template<> struct Vec<float>
+            {
+                static constexpr size_t Width = 4;
+                static __m128 Load(const float* p) { return _mm_loadu_ps(p); }
+                static void Store(float* p, __m128 v) { _mm_storeu_ps(p, v); }
+                static __m128 Set1(float s) { return _mm_set1_ps(s); }
+                static __m128 Add(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+                static __m128 Sub(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+                static __m128 Mul(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+                static __m128 Div(__m128 a, __m128 b) { return _mm_div_ps(a, b); }
+                static __m128 Sqrt(__m128 a) { return _mm_sqrt_ps(a); }
+                static float Sum(__m128 v) { alignas(16) float l[4]; _mm_store_ps(l, v); return (l[0] + l[1]) + (l[2] + l[3]); }
+            };
+
+            template<> struct Vec<double>
+            {
+                static constexpr size_t Width = 2;
+                static __m128d Load(const double* p) { return _mm_loadu_pd(p); }
+                static void Store(double* p, __m128d v) { _mm_storeu_pd(p, v); }
+                static __m128d Set1(double s) { return _mm_set1_pd(s); }
+                static __m128d Add(__m128d a, __m128d b) { return _mm_add_pd(a, b); }
+                static __m128d Sub(__m128d a, __m128d b) { return _mm_sub_pd(a, b); }
+                static __m128d Mul(__m128d a, __m128d b) { return _mm_mul_pd(a, b); }
+                static __m128d Div(__m128d a, __m128d b) { return _mm_div_pd(a, b); }
+                static __m128d Sqrt(__m128d a) { return _mm_sqrt_pd(a); }
+                static double Sum(__m128d v) { alignas(16) double l[2]; _mm_store_pd(l, v); return l[0] + l[1]; }
+            };
+
+            template<> struct Vec<int32_t>
+            {
+                static constexpr size_t Width = 4;
+                static __m128i Load(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+                static void Store(int32_t* p, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+                static __m128i Set1(int32_t s) { return _mm_set1_epi32(s); }
+                static __m128i Add(__m128i a, __m128i b) { return _mm_add_epi32(a, b); }
+                static __m128i Sub(__m128i a, __m128i b) { return _mm_sub_epi32(a, b); }
+                static __m128i Mul(__m128i a, __m128i b) { return _mm_mullo_epi32(a, b); }
+                static int32_t Sum(__m128i v)
+                {
+                    alignas(16) uint32_t l[4];
+                    _mm_store_si128(reinterpret_cast<__m128i*>(l), v);
+                    return static_cast<int32_t>(l[0] + l[1] + l[2] + l[3]);
+                }
+            };
+
+            #include "SimdKernels.inl"
+        } // namespace sse41
+JL_END_TARGET_REGION
+
+JL_TARGET_REGION("avx2")
+        namespace avx2
+        {
+            template<typename T> struct Vec;
+
+            template<> struct Vec<float>
+            {
+                static constexpr size_t Width = 8;
+                static __m256 Load(const float* p) { return _mm256_loadu_ps(p); }
+                static void Store(float* p, __m256 v) { _mm256_storeu_ps(p, v); }
+                static __m256 Set1(float s) { return _mm256_set1_ps(s); }
+                static __m256 Add(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+                static __m256 Sub(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+                static __m256 Mul(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+                static __m256 Div(__m256 a, __m256 b) { return _mm256_div_ps(a, b); }
+                static __m256 Sqrt(__m256 a) { return _mm256_sqrt_ps(a); }
+                static float Sum(__m256 v)
+                {
+                    alignas(32) float l[8];
+                    _mm256_store_ps(l, v);
+                    return ((l[0] + l[1]) + (l[2] + l[3])) + ((l[4] + l[5]) + (l[6] + l[7]));
+                }
+            };
+
+            template<> struct Vec<double>
+            {
+                static constexpr size_t Width = 4;
+                static __m256d Load(const double* p) { return _mm256_loadu_pd(p); }
+                static void Store(double* p, __m256d v) { _mm256_storeu_pd(p, v); }
+                static __m256d Set1(double s) { return _mm256_set1_pd(s); }
+                static __m256d Add(__m256d a, __m256d b) { return _mm256_add_pd(a, b); }
+                static __m256d Sub(__m256d a, __m256d b) { return _mm256_sub_pd(a, b); }
+                static __m256d Mul(__m256d a, __m256d b) { return _mm256_mul_pd(a, b); }
+                static __m256d Div(__m256d a, __m256d b) { return _mm256_div_pd(a, b); }
+                static __m256d Sqrt(__m256d a) { return _mm256_sqrt_pd(a); }
+                static double Sum(__m256d v) { alignas(32) double l[4]; _mm256_store_pd(l, v); return (l[0] + l[1]) + (l[2] + l[3]); }
+            };
+
+            template<> struct Vec<int32_t>
+            {
+                static constexpr size_t Width = 8;
+                static __m256i Load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+                static void Store(int32_t* p, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+                static __m256i Set1(int32_t s) { return _mm256_set1_epi32(s); }
+                static __m256i Add(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
+                static __m256i Sub(__m256i a, __m256i b) { return _mm256_sub_epi32(a, b); }
+                static __m256i Mul(__m256i a, __m256i b) { return _mm256_mullo_epi32(a, b); }
+                static int32_t Sum(__m256i v)
+                {
+                    alignas(32) uint32_t l[8];
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(l), v);
+                    uint32_t sum = 0;
+                    for (uint32_t x : l) sum += x;
+                    return static_cast<int32_t>(sum);
+                }
+            };
+
+            #include "SimdKernels.inl"
+        } // namespace avx2
+JL_END_TARGET_REGION
+
+JL_TARGET_REGION("avx512f")
+        namespace avx512
+        {
+            template<typename T> struct Vec;
+
+            template<> struct Vec<float>
+            {
+                static constexpr size_t Width = 16;
+                static __m512 Load(const float* p) { return _mm512_loadu_ps(p); }
+                static void Store(float* p, __m512 v) { _mm512_storeu_ps(p, v); }
+                static __m512 Set1(float s) { return _mm512_set1_ps(s); }
+                static __m512 Add(__m512 a, __m512 b) { return _mm512_add_ps(a, b); }
+                static __m512 Sub(__m512 a, __m512 b) { return _mm512_sub_ps(a, b); }
+                static __m512 Mul(__m512 a, __m512 b) { return _mm512_mul_ps(a, b); }
+                static __m512 Div(__m512 a, __m512 b) { return _mm512_div_ps(a, b); }
+                static __m512 Sqrt(__m512 a) { return _mm512_sqrt_ps(a); }
+                static float Sum(__m512 v) { return _mm512_reduce_add_ps(v); }
+            };
+
+            template<> struct Vec<double>
+            {
+                static constexpr size_t Width = 8;
+                static __m512d Load(const double* p) { return _mm512_loadu_pd(p); }
+                static void Store(double* p, __m512d v) { _mm512_storeu_pd(p, v); }
+                static __m512d Set1(double s) { return _mm512_set1_pd(s); }
+                static __m512d Add(__m512d a, __m512d b) { return _mm512_add_pd(a, b); }
+                static __m512d Sub(__m512d a, __m512d b) { return _mm512_sub_pd(a, b); }
+                static __m512d Mul(__m512d a, __m512d b) { return _mm512_mul_pd(a, b); }
+                static __m512d Div(__m512d a, __m512d b) { return _mm512_div_pd(a, b); }
+                static __m512d Sqrt(__m512d a) { return _mm512_sqrt_pd(a); }
+                static double Sum(__m512d v) { return _mm512_reduce_add_pd(v); }
+            };
+
+            template<> struct Vec<int32_t>
+            {
+                static constexpr size_t Width = 16;
+                static __m512i Load(const int32_t* p) { return _mm512_loadu_si512(p); }
+                static void Store(int32_t* p, __m512i v) { _mm512_storeu_si512(p, v); }
+                static __m512i Set1(int32_t s) { return _mm512_set1_epi32(s); }
+                static __m512i Add(__m512i a, __m512i b) { return _mm512_add_epi32(a, b); }
+                static __m512i Sub(__m512i a, __m512i b) { return _mm512_sub_epi32(a, b); }
+                static __m512i Mul(__m512i a, __m512i b) { return _mm512_mullo_epi32(a, b); }
+                static int32_t Sum(__m512i v) { return _mm512_reduce_add_epi32(v); }
+            };
+
+            #include "SimdKernels.inl"
+        } // namespace avx512
+JL_END_TARGET_REGION
+
+#endif // JL_SIMD_X86
+
+        namespace
+        {
+            std::atomic<int> g_level{ -1 };
+
+#if JL_SIMD_X86 && defined(_MSC_VER)
+    #if defined(__clang__)
+            __attribute__((target("xsave")))
+    #endif
+            SimdLevel DetectX86()
+            {
+                int r[4];
+                __cpuid(r, 0);
+                const int maxLeaf = r[0];
+
+                __cpuid(r, 1);
+                const bool sse41 = (r[2] & (1 << 19)) != 0;
+                const bool osxsave = (r[2] & (1 << 27)) != 0;
+
+                // the OS has to save the ymm / zmm registers on context switches
+                const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+                const bool ymm = (xcr0 & 0x6) == 0x6;
+                const bool zmm = (xcr0 & 0xE6) == 0xE6;
+
+                bool avx2 = false, avx512f = false;
+                if (maxLeaf >= 7)
+                {
+                    __cpuidex(r, 7, 0);
+                    avx2 = (r[1] & (1 << 5)) != 0;
+                    avx512f = (r[1] & (1 << 16)) != 0;
+                }
+
+                if (avx512f && zmm) return SimdLevel::AVX512;
+                if (avx2 && ymm) return SimdLevel::AVX2;
+                if (sse41) return SimdLevel::SSE41;
+                return SimdLevel::Scalar;
+            }
+#elif JL_SIMD_X86
+            SimdLevel DetectX86()
+            {
+                // __builtin_cpu_supports also checks that the OS enabled the wider register state
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+                if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+                if (__builtin_cpu_supports("sse4.1")) return SimdLevel::SSE41;
+                return SimdLevel::Scalar;
+            }
+#endif
+        } // namespace
+
+#if JL_SIMD_X86
+    #define JL_SIMD_DISPATCH(Kernel, ...)                                           \
+        switch (GetSimdLevel())                                                     \
+        {                                                                           \
+        case SimdLevel::AVX512: return avx512::Kernel(__VA_ARGS__);                 \
+        case SimdLevel::AVX2:   return avx2::Kernel(__VA_ARGS__);                   \
+        case SimdLevel::SSE41:  return sse41::Kernel(__VA_ARGS__);                  \
+        default:                return scalar::Kernel(__VA_ARGS__);                 \
+        }
+#else
+    #define JL_SIMD_DISPATCH(Kernel, ...) return scalar::Kernel(__VA_ARGS__);
+#endif
+
+        UTILS_API SimdLevel DetectSimdLevel()
+        {
+#if JL_SIMD_X86
+            static const SimdLevel detected = DetectX86();
+            return detected;
+#else
+            return SimdLevel::Scalar;
+#endif
+        }
+
+        UTILS_API SimdLevel GetSimdLevel()
+        {
+            int level = g_level.load(std::memory_order_relaxed);
+            if (level < 0)
+            {
+                level = static_cast<int>(DetectSimdLevel());
+                g_level.store(level, std::memory_order_relaxed);
+            }
+            return static_cast<SimdLevel>(level);
+        }
+
+        UTILS_API void SetSimdLevel(SimdLevel level)
+        {
+            if (static_cast<int>(level) > static_cast<int>(DetectSimdLevel())) level = DetectSimdLevel();
+            g_level.store(static_cast<int>(level), std::memory_order_relaxed);
+        }
+
+        UTILS_API const char* ToString(SimdLevel level)
+        {
+            switch (level)
+            {
+            case SimdLevel::SSE41:  return "SSE4.1";
+            case SimdLevel::AVX2:   return "AVX2";
+            case SimdLevel::AVX512: return "AVX-512";
+            default:                return "Scalar";
+            }
+        }
+
+        UTILS_API void Add(const float* a, const float* b, float* out, size_t n) { JL_SIMD_DISPATCH(Add, a, b, out, n) }
+        UTILS_API void Add(const double* a, const double* b, double* out, size_t n) { JL_SIMD_DISPATCH(Add, a, b, out, n) }
+        UTILS_API void Add(const int32_t* a, const int32_t* b, int32_t* out, size_t n) { JL_SIMD_DISPATCH(Add, a, b, out, n) }
+
+        UTILS_API void Subtract(const float* a, const float* b, float* out, size_t n) { JL_SIMD_DISPATCH(Subtract, a, b, out, n) }
+        UTILS_API void Subtract(const double* a, const double* b, double* out, size_t n) { JL_SIMD_DISPATCH(Subtract, a, b, out, n) }
+        UTILS_API void Subtract(const int32_t* a, const int32_t* b, int32_t* out, size_t n) { JL_SIMD_DISPATCH(Subtract, a, b, out, n) }
+
+        UTILS_API void Multiply(const float* a, const float* b, float* out, size_t n) { JL_SIMD_DISPATCH(Multiply, a, b, out, n) }
+        UTILS_API void Multiply(const double* a, const double* b, double* out, size_t n) { JL_SIMD_DISPATCH(Multiply, a, b, out, n) }
+        UTILS_API void Multiply(const int32_t* a, const int32_t* b, int32_t* out, size_t n) { JL_SIMD_DISPATCH(Multiply, a, b, out, n) }
+
+        UTILS_API void Scale(const float* a, float s, float* out, size_t n) { JL_SIMD_DISPATCH(Scale, a, s, out, n) }
+        UTILS_API void Scale(const double* a, double s, double* out, size_t n) { JL_SIMD_DISPATCH(Scale, a, s, out, n) }
+        UTILS_API void Scale(const int32_t* a, int32_t s, int32_t* out, size_t n) { JL_SIMD_DISPATCH(Scale, a, s, out, n) }
+
+        UTILS_API void Divide(const float* a, float s, float* out, size_t n) { JL_SIMD_DISPATCH(Divide, a, s, out, n) }
+        UTILS_API void Divide(const double* a, double s, double* out, size_t n) { JL_SIMD_DISPATCH(Divide, a, s, out, n) }
+        UTILS_API void Divide(const int32_t* a, int32_t s, int32_t* out, size_t n) { scalar::Divide(a, s, out, n); }
+
+        UTILS_API void Divide(const float* a, const float* b, float* out, size_t n) { JL_SIMD_DISPATCH(Divide, a, b, out, n) }
+        UTILS_API void Divide(const double* a, const double* b, double* out, size_t n) { JL_SIMD_DISPATCH(Divide, a, b, out, n) }
+
+        UTILS_API void AddScalar(const float* a, float s, float* out, size_t n) { JL_SIMD_DISPATCH(AddScalar, a, s, out, n) }
+        UTILS_API void AddScalar(const double* a, double s, double* out, size_t n) { JL_SIMD_DISPATCH(AddScalar, a, s, out, n) }
+        UTILS_API void AddScalar(const int32_t* a, int32_t s, int32_t* out, size_t n) { JL_SIMD_DISPATCH(AddScalar, a, s, out, n) }
+
+        UTILS_API void ScaleAdd(const float* a, float s, const float* b, float* out, size_t n) { JL_SIMD_DISPATCH(ScaleAdd, a, s, b, out, n) }
+        UTILS_API void ScaleAdd(const double* a, double s, const double* b, double* out, size_t n) { JL_SIMD_DISPATCH(ScaleAdd, a, s, b, out, n) }
+        UTILS_API void ScaleAdd(const int32_t* a, int32_t s, const int32_t* b, int32_t* out, size_t n) { JL_SIMD_DISPATCH(ScaleAdd, a, s, b, out, n) }
+
+        UTILS_API void MultiplyAdd(const float* a, const float* b, const float* c, float* out, size_t n) { JL_SIMD_DISPATCH(MultiplyAdd, a, b, c, out, n) }
+        UTILS_API void MultiplyAdd(const double* a, const double* b, const double* c, double* out, size_t n) { JL_SIMD_DISPATCH(MultiplyAdd, a, b, c, out, n) }
+        UTILS_API void MultiplyAdd(const int32_t* a, const int32_t* b, const int32_t* c, int32_t* out, size_t n) { JL_SIMD_DISPATCH(MultiplyAdd, a, b, c, out, n) }
+
+        UTILS_API void Sqrt(const float* a, float* out, size_t n) { JL_SIMD_DISPATCH(Sqrt, a, out, n) }
+        UTILS_API void Sqrt(const double* a, double* out, size_t n) { JL_SIMD_DISPATCH(Sqrt, a, out, n) }
+
+        UTILS_API float Dot(const float* a, const float* b, size_t n) { JL_SIMD_DISPATCH(Dot, a, b, n) }
+        UTILS_API double Dot(const double* a, const double* b, size_t n) { JL_SIMD_DISPATCH(Dot, a, b, n) }
+        UTILS_API int32_t Dot(const int32_t* a, const int32_t* b, size_t n) { JL_SIMD_DISPATCH(Dot, a, b, n) }
+
+    } // namespace simd
+
+} // namespace jl
@@ -0,0 +1,145 @@
+/*
+SimdKernels.inl
+
+Kernel bodies shared by every instruction set in Simd.cpp. This file is included once per instruction
+set, inside a namespace that defines Vec<T> for float, double and int32_t with:
+    Width, Load, Store, Add, Sub, Mul, Set1, Sum   (and Div, Sqrt for the floating point types)
+and inside a target region so that every function below is compiled for that instruction set.
+*/
+
+template<typename T>
+void Add(const T* a, const T* b, T* out, size_t n)
+{
+    using V = Vec<T>;
+    size_t i = 0;
+    for (; i + V::Width <= n; i += V::Width)
+        V::Store(out + i, V::Add(V::Load(a + i), V::Load(b + i)));
+    for (; i < n; ++i)
+        out[i] = a[i] + b[i];
+}
+
+template<typename T>
+void Subtract(const T* a, const T* b, T* out, size_t n)
+{
+    using V = Vec<T>;
+    size_t i = 0;
+    for (; i + V::Width <= n; i += V::Width)
+        V::Store(out + i, V::Sub(V::Load(a + i), V::Load(b + i)));
+    for (; i < n; ++i)
+        out[i] = a[i] - b[i];
+}
+
+template<typename T>
+void Multiply(const T* a, const T* b, T* out, size_t n)
+{
+    using V = Vec<T>;
+    size_t i = 0;
+    for (; i + V::Width <= n; i += V::Width)
+        V::Store(out + i, V::Mul(V::Load(a + i), V::Load(b + i)));
+    for (; i < n; ++i)
+        out[i] = a[i] * b[i];
+}
+
+template<typename T>
+void Scale(const T* a, T s, T* out, size_t n)
+{
+    using V = Vec<T>;
+    const auto vs = V::Set1(s);
+    size_t i = 0;
+    for (; i + V::Width <= n; i += V::Width)
+        V::Store(out + i, V::Mul(V::Load(a + i), vs));
+    for (; i < n; ++i)
+        out[i] = a[i] * s;
+}
+
+template<typename T>
+void Divide(const T* a, T s, T* out, size_t n)
+{
+    using V = Vec<T>;
+    const auto vs = V::Set1(s);
+    size_t i = 0;
+    for (; i + V::Width <= n; i += V::Width)
+        V::Store(out + i, V::Div(V::Load(a + i), vs));
+    for (; i < n; ++i)
+        out[i] = a[i] / s;
+}
+
+template<typename T>
+void Divide(const T* a, const T* b, T* out, size_t n)
+{
+    using V = Vec<T>;
+    size_t i = 0;
+    for (; i + V::Width <= n; i += V::Width)
+        V::Store(out + i, V::Div(V::Load(a + i), V::Load(b + i)));
+    for (; i < n; ++i)
+        out[i] = a[i] / b[i];
+}
+
+template<typename T>
+void AddScalar(const T* a, T s, T* out, size_t n)
+{
+    using V = Vec<T>;
+    const auto vs = V::Set1(s);
+    size_t i = 0;
+    for (; i + V::Width <= n; i += V::Width)
+        V::Store(out + i, V::Add(V::Load(a + i), vs));
+    for (; i < n; ++i)
+        out[i] = a[i] + s;
+}
+
+// multiply and add stay two roundings, Simd.cpp is built with -ffp-contract=off so the compiler cannot fuse them into
+// an FMA (GCC does inside the AVX-512 target region), and every level matches the scalar loop exactly
+template<typename T>
+void ScaleAdd(const T* a, T s, const T* b, T* out, size_t n)
+{
+    using V = Vec<T>;
+    const auto vs = V::Set1(s);
+    size_t i = 0;
+    for (; i + V::Width <= n; i += V::Width)
+        V::Store(out + i, V::Add(V::Mul(V::Load(a + i), vs), V::Load(b + i)));
+    for (; i < n; ++i)
+        out[i] = a[i] * s + b[i];
+}
+
+template<typename T>
+void MultiplyAdd(const T* a, const T* b, const T* c, T* out, size_t n)
+{
+    using V = Vec<T>;
+    size_t i = 0;
+    for (; i + V::Width <= n; i += V::Width)
+        V::Store(out + i, V::Add(V::Mul(V::Load(a + i), V::Load(b + i)), V::Load(c + i)));
+    for (; i < n; ++i)
+        out[i] = a[i] * b[i] + c[i];
+}
+
+template<typename T>
+void Sqrt(const T* a, T* out, size_t n)
+{
+    using V = Vec<T>;
+    size_t i = 0;
+    for (; i + V::Width <= n; i += V::Width)
+        V::Store(out + i, V::Sqrt(V::Load(a + i)));
+    for (; i < n; ++i)
+        out[i] = std::sqrt(a[i]);
+}
+
+template<typename T>
+T Dot(const T* a, const T* b, size_t n)
+{
+    using V = Vec<T>;
+    // two independent accumulators hide the latency of the vector add
+    auto acc0 = V::Set1(T(0));
+    auto acc1 = V::Set1(T(0));
+    size_t i = 0;
+    for (; i + 2*V::Width <= n; i += 2*V::Width)
+    {
+        acc0 = V::Add(acc0, V::Mul(V::Load(a + i), V::Load(b + i)));
+        acc1 = V::Add(acc1, V::Mul(V::Load(a + i + V::Width), V::Load(b + i + V::Width)));
+    }
+    for (; i + V::Width <= n; i += V::Width)
+        acc0 = V::Add(acc0, V::Mul(V::Load(a + i), V::Load(b + i)));
+    T sum = V::Sum(V::Add(acc0, acc1));
+    for (; i < n; ++i)
+        sum += a[i] * b[i];
+    return sum;
+}
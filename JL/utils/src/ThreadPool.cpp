@@ -0,0 +1,178 @@
+#include "JL/utils/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+
+namespace jl
+{
+    namespace
+    {
+        // Set on pool workers and on a caller while it runs tasks, a nested Run is serial
+        thread_local bool insideRun = false;
+    }
+
+    struct ThreadPool::Job
+    {
+        // The tasks dealt to one thread, it takes from the front and thieves from the back
+        struct Queue
+        {
+            std::mutex Mutex;
+            std::deque<size_t> Tasks;
+        };
+
+        explicit Job(size_t threads) : Queues(threads) {}
+
+        const std::function<void(size_t)>* Task = nullptr;
+        std::vector<Queue> Queues;
+        std::atomic<size_t> Remaining{0};
+        std::mutex DoneMutex;
+        std::condition_variable Done;
+
+        // the first exception thrown by a task, the tasks after it are only counted
+        std::atomic<bool> Failed{false};
+        std::mutex ErrorMutex;
+        std::exception_ptr Error;
+
+        bool Pop(size_t thread, size_t& task)
+        {
+            {
+                Queue& own = Queues[thread];
+                std::lock_guard<std::mutex> lock(own.Mutex);
+                if (!own.Tasks.empty())
+                {
+                    task = own.Tasks.front();
+                    own.Tasks.pop_front();
+                    return true;
+                }
+            }
+            for (size_t i = 1; i < Queues.size(); ++i)
+            {
+                Queue& victim = Queues[(thread + i) % Queues.size()];
+                std::lock_guard<std::mutex> lock(victim.Mutex);
+                if (!victim.Tasks.empty())
+                {
+                    task = victim.Tasks.back();
+                    victim.Tasks.pop_back();
+                    return true;
+                }
+            }
+            // tasks are only added before the job starts, so every queue stays empty from here on
+            return false;
+        }
+
+        void Work(size_t thread)
+        {
+            size_t task;
+            while (Pop(thread, task))
+            {
+                if (!Failed.load(std::memory_order_relaxed))
+                {
+                    try
+                    {
+                        (*Task)(task);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(ErrorMutex);
+                        if (!Error) Error = std::current_exception();
+                        Failed = true;
+                    }
+                }
+                if (Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    std::lock_guard<std::mutex> lock(DoneMutex);
+                    Done.notify_all();
+                }
+            }
+        }
+    };
+
+    UTILS_API ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            Stop = true;
+        }
+        Wake.notify_all();
+        for (auto& w : Workers) w.join();
+    }
+
+    UTILS_API ThreadPool& ThreadPool::Shared()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    UTILS_API size_t ThreadPool::NumWorkers()
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        return Workers.size();
+    }
+
+    UTILS_API void ThreadPool::RunTasks(size_t taskCount, size_t numThreads, const std::function<void(size_t)>& f)
+    {
+        if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+        const size_t threads = std::min(numThreads, taskCount);
+
+        if (threads <= 1 || insideRun)
+        {
+            for (size_t task = 0; task < taskCount; ++task) f(task);
+            return;
+        }
+
+        std::lock_guard<std::mutex> run(RunMutex);
+
+        auto job = std::make_shared<Job>(threads);
+        job->Task = &f;
+        job->Remaining = taskCount;
+        for (size_t t = 0; t < threads; ++t)
+            for (size_t task = taskCount * t / threads; task < taskCount * (t + 1) / threads; ++task)
+                job->Queues[t].Tasks.push_back(task);
+
+        {
+            std::lock_guard<std::mutex> lock(Mutex);
+            while (Workers.size() < threads - 1)
+                Workers.emplace_back(&ThreadPool::WorkerLoop, this, Workers.size());
+            Current = job;
+            ++Generation;
+        }
+        Wake.notify_all();
+
+        insideRun = true;
+        job->Work(0);
+        insideRun = false;
+
+        // a worker may still be finishing a task it took
+        std::unique_lock<std::mutex> lock(job->DoneMutex);
+        job->Done.wait(lock, [&] { return job->Remaining.load(std::memory_order_acquire) == 0; });
+        lock.unlock();
+
+        {
+            std::lock_guard<std::mutex> release(Mutex);
+            Current.reset();
+        }
+        if (job->Error) std::rethrow_exception(job->Error);
+    }
+
+    void ThreadPool::WorkerLoop(size_t index)
+    {
+        insideRun = true;
+        uint64_t seen = 0;
+        for (;;)
+        {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(Mutex);
+                Wake.wait(lock, [&] { return Stop || Generation != seen; });
+                if (Stop) return;
+                seen = Generation;
+                job = Current;
+            }
+            // worker index takes the run of thread index + 1, the caller has run 0
+            if (job && index + 1 < job->Queues.size()) job->Work(index + 1);
+        }
+    }
+
+} // namespace jl
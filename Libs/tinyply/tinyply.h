@@ -33,6 +33,9 @@
 #include <map>
 #include <algorithm>
 #include <functional>
+#include <charconv>
+#include <stdexcept>
+#include <utility>
 
 namespace tinyply
 {
@@ -117,6 +120,71 @@ namespace tinyply
         std::vector<PlyProperty> properties;
     };
 
+    /*
+     * Runs task(0), ..., task(count - 1) concurrently and returns once every call has finished, so that the
+     * threads of the options below can come from an application's thread pool. When empty, tinyply starts and
+     * joins its own threads for each call.
+     */
+    using PlyExecutor = std::function<void(size_t count, const std::function<void(size_t)> & task)>;
+
+    struct PlyReadOptions
+    {
+        // Threads that decode binary elements without list properties. 1 parses serially as before,
+        // 0 uses every hardware thread. Other files (ascii, lists) are always parsed serially.
+        size_t num_threads {1};
+        PlyExecutor executor {};
+
+        // Ascii files are loaded into memory once and their numbers converted with std::from_chars
+        // instead of locale aware stream extraction of every token.
+        bool fast_ascii {false};
+    };
+
+    struct PlyWriteOptions
+    {
+        // Threads that encode the rows of each block of a binary file (or of an ascii file with fast_ascii).
+        // 0 uses every hardware thread.
+        size_t num_threads {1};
+        PlyExecutor executor {};
+
+        // Ascii numbers are formatted with std::to_chars into row buffers instead of stream insertion of every
+        // value. Floating point values are written in their shortest form that reads back exactly.
+        bool fast_ascii {false};
+    };
+
+    /*
+     * Reverses the byte order of `count` contiguous values of `width` bytes (1, 2, 4 or 8) in place. Uses
+     * SSSE3 / AVX2 byte shuffles when the CPU has them. Big-endian files are converted with this.
+     */
+    void endian_swap_values(uint8_t * data, size_t count, size_t width) noexcept;
+
+    /*
+     * Whitespace separated tokens of an ascii payload held in memory, and their conversion with std::from_chars.
+     * The fast ascii reader parses with these, and so can readers of ascii files outside tinyply.
+     */
+    struct AsciiCursor
+    {
+        const char * pos;
+        const char * end;
+
+        std::pair<const char *, const char *> token()
+        {
+            while (pos < end && (*pos == ' ' || *pos == '\n' || *pos == '\r' || *pos == '\t')) ++pos;
+            const char * begin = pos;
+            while (pos < end && *pos != ' ' && *pos != '\n' && *pos != '\r' && *pos != '\t') ++pos;
+            if (begin == pos) throw std::runtime_error("unexpected end of ascii data");
+            return { begin, pos };
+        }
+    };
+
+    template<typename T> inline T ply_read_ascii_fast(AsciiCursor & cursor)
+    {
+        const auto token = cursor.token();
+        T value;
+        const auto result = std::from_chars(token.first, token.second, value);
+        if (result.ec != std::errc() || result.ptr != token.second) throw std::runtime_error("invalid ascii value: " + std::string(token.first, token.second));
+        return value;
+    }
+
     struct PlyFile
     {
         struct PlyFileImpl;
@@ -139,12 +207,24 @@ namespace tinyply
          */
         void read(std::istream & is);
 
+        /*
+         * With more than one thread, binary files whose elements up to the last requested one have a fixed row
+         * size (no list properties) are read in large blocks and the rows of each block are decoded in parallel.
+         */
+        void read(std::istream & is, const PlyReadOptions & options);
+
         /*
          * `write` performs no validation and assumes that the data passed into
          * `add_properties_to_element` is well-formed.
          */
         void write(std::ostream & os, bool isBinary);
 
+        /*
+         * Binary files are encoded a block of rows at a time and each block is written with a single call;
+         * with more than one thread the rows of large blocks are encoded in parallel.
+         */
+        void write(std::ostream & os, bool isBinary, const PlyWriteOptions & options);
+
         /*
          * These functions are valid after a call to `parse_header(...)`. In the case of
          * writing, get_comments() reference may also be used to add new comments to the ply header.
@@ -153,13 +233,14 @@ namespace tinyply
         std::vector<std::string> get_info() const;
         std::vector<std::string> & get_comments();
         bool is_binary_file() const;
+        bool is_big_endian_file() const;
 
         /*
-         * In the general case where |list_size_hint| is zero, `read` performs a two-pass
-         * parse to support variable length lists. The most general use of the
+         * In the general case where |list_size_hint| is zero, `read` decodes the lists into
+         * growable blocks and copies them into one buffer at the end. The most general use of the
          * ply format is storing triangle meshes. When this fact is known a-priori, we can pass
          * an expected list length that will apply to this element. Doing so results in an up-front
-         * memory allocation and a single-pass import, a 2x performance optimization.
+         * memory allocation and saves the final copy.
          */
         std::shared_ptr<PlyData> request_properties_from_element(const std::string & elementKey,
             const std::vector<std::string> propertyKeys, const uint32_t list_size_hint = 0);
@@ -187,7 +268,29 @@ namespace tinyply
 #include <functional>
 #include <type_traits>
 #include <iostream>
+#include <charconv>
 #include <cstring>
+#include <iterator>
+#include <thread>
+#include <mutex>
+#include <exception>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define TINYPLY_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#else
+    #define TINYPLY_X86 0
+#endif
+
+// Compiles a single function for an instruction set the rest of the file is not built for
+#if TINYPLY_X86 && (defined(__GNUC__) || defined(__clang__))
+    #define TINYPLY_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define TINYPLY_TARGET(isa)
+#endif
 
 namespace tinyply
 {
@@ -214,6 +317,125 @@ template<> inline int64_t endian_swap<int64_t, int64_t>(const int64_t & v) noexc
 template<> inline float endian_swap<uint32_t, float>(const uint32_t & v) noexcept { union { float f; uint32_t i; }; i = endian_swap<uint32_t, uint32_t>(v); return f; }
 template<> inline double endian_swap<uint64_t, double>(const uint64_t & v) noexcept { union { double d; uint64_t i; }; i = endian_swap<uint64_t, uint64_t>(v); return d; }
 
+// Byte swap of whole vectors: a byte shuffle whose control reverses every `width` byte group. Vector widths are
+// multiples of every value width, so values never straddle two vectors. Both return the number of bytes swapped,
+// the caller finishes the tail.
+#if TINYPLY_X86
+inline void endian_swap_control(uint8_t (&control)[16], size_t width) noexcept
+{
+    for (size_t i = 0; i < 16; ++i) control[i] = static_cast<uint8_t>(i - i % width + (width - 1 - i % width));
+}
+
+TINYPLY_TARGET("ssse3") inline size_t endian_swap_ssse3(uint8_t * data, size_t num_bytes, size_t width) noexcept
+{
+    uint8_t control[16];
+    endian_swap_control(control, width);
+    const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(control));
+    size_t i = 0;
+    for (; i + 16 <= num_bytes; i += 16)
+    {
+        __m128i * p = reinterpret_cast<__m128i *>(data + i);
+        _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+    }
+    return i;
+}
+
+TINYPLY_TARGET("avx2") inline size_t endian_swap_avx2(uint8_t * data, size_t num_bytes, size_t width) noexcept
+{
+    uint8_t control[16];
+    endian_swap_control(control, width);
+    // vpshufb shuffles within each 128 bit lane, both lanes take the same control
+    const __m256i mask = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(control)));
+    size_t i = 0;
+    for (; i + 64 <= num_bytes; i += 64)
+    {
+        __m256i * p = reinterpret_cast<__m256i *>(data + i);
+        const __m256i a = _mm256_loadu_si256(p);
+        const __m256i b = _mm256_loadu_si256(p + 1);
+        _mm256_storeu_si256(p, _mm256_shuffle_epi8(a, mask));
+        _mm256_storeu_si256(p + 1, _mm256_shuffle_epi8(b, mask));
+    }
+    for (; i + 32 <= num_bytes; i += 32)
+    {
+        __m256i * p = reinterpret_cast<__m256i *>(data + i);
+        _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask));
+    }
+    return i;
+}
+
+// 2: AVX2 (with OS support for the ymm registers), 1: SSSE3, 0: neither
+inline int endian_swap_level() noexcept
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    __cpuid(info, 1);
+    const bool ssse3 = (info[2] & (1 << 9)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx2 = false;
+    if (max_leaf >= 7 && osxsave && (_xgetbv(0) & 6) == 6)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+    return avx2 ? 2 : ssse3 ? 1 : 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? 2 : __builtin_cpu_supports("ssse3") ? 1 : 0;
+#endif
+}
+#endif // TINYPLY_X86
+
+void endian_swap_values(uint8_t * data, size_t count, size_t width) noexcept
+{
+    if (width < 2) return;
+    const size_t num_bytes = count * width;
+    size_t i = 0;
+#if TINYPLY_X86
+    static const int level = endian_swap_level();
+    if (level == 2) i = endian_swap_avx2(data, num_bytes, width);
+    else if (level == 1) i = endian_swap_ssse3(data, num_bytes, width);
+#endif
+    for (; i < num_bytes; i += width)
+    {
+        uint8_t * p = data + i;
+        switch (width)
+        {
+        case 2: { uint16_t v; std::memcpy(&v, p, 2); v = endian_swap<uint16_t, uint16_t>(v); std::memcpy(p, &v, 2); break; }
+        case 4: { uint32_t v; std::memcpy(&v, p, 4); v = endian_swap<uint32_t, uint32_t>(v); std::memcpy(p, &v, 4); break; }
+        case 8: { uint64_t v; std::memcpy(&v, p, 8); v = endian_swap<uint64_t, uint64_t>(v); std::memcpy(p, &v, 8); break; }
+        default: std::reverse(p, p + width); break;
+        }
+    }
+}
+
+// task(0) .. task(count - 1), on the executor when there is one. Otherwise the calling thread runs task(0) and
+// starts a thread for each other task; they are joined before the first exception of a task is rethrown.
+inline void run_concurrently(const PlyExecutor & executor, size_t count, const std::function<void(size_t)> & task)
+{
+    if (count <= 1) { if (count == 1) task(0); return; }
+    if (executor) { executor(count, task); return; }
+
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto guarded = [&](size_t t)
+    {
+        try { task(t); }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < count; ++t) workers.emplace_back(guarded, t);
+    guarded(0);
+    for (auto & w : workers) w.join();
+    if (error) std::rethrow_exception(error);
+}
+
 inline uint32_t hash_fnv1a(const std::string & str) noexcept
 {
     static const uint32_t fnv1aBase32 = 0x811C9DC5u;
@@ -244,10 +466,49 @@ struct PlyFile::PlyFileImpl
         size_t totalSizeBytes{ 0 };
     };
 
+    // Growable storage for lists read without a size hint: blocks are appended as needed (nothing is
+    // moved while reading) and copied into one Buffer once the element has been parsed.
+    struct PlyDataArena
+    {
+        static constexpr size_t block_size = size_t(1) << 20; // larger lists get a block of their own
+
+        std::vector<std::pair<std::unique_ptr<uint8_t[]>, size_t>> blocks; // storage and bytes used
+        size_t available {0};
+        size_t total {0};
+
+        uint8_t * allocate(size_t bytes)
+        {
+            if (bytes > available)
+            {
+                available = std::max(block_size, bytes);
+                blocks.emplace_back(std::unique_ptr<uint8_t[]>(new uint8_t[available]), 0);
+            }
+            auto & block = blocks.back();
+            uint8_t * ptr = block.first.get() + block.second;
+            block.second += bytes;
+            available -= bytes;
+            total += bytes;
+            return ptr;
+        }
+
+        Buffer compact() const
+        {
+            Buffer out(total);
+            size_t offset = 0;
+            for (auto & block : blocks)
+            {
+                std::memcpy(out.get() + offset, block.first.get(), block.second);
+                offset += block.second;
+            }
+            return out;
+        }
+    };
+
     struct ParsingHelper
     {
         std::shared_ptr<PlyData> data;
         std::shared_ptr<PlyDataCursor> cursor;
+        std::shared_ptr<PlyDataArena> arena; // lists without a size hint
         uint32_t list_size_hint;
     };
 
@@ -268,8 +529,8 @@ struct PlyFile::PlyFileImpl
     std::vector<std::string> objInfo;
     uint8_t scratch[64]; // large enough for max list size
 
-    void read(std::istream & is);
-    void write(std::ostream & os, bool isBinary);
+    void read(std::istream & is, const PlyReadOptions & options);
+    void write(std::ostream & os, bool isBinary, const PlyWriteOptions & options);
 
     std::shared_ptr<PlyData> request_properties_from_element(const std::string & elementKey,
         const std::vector<std::string> propertyKeys,
@@ -285,7 +546,10 @@ struct PlyFile::PlyFileImpl
     std::vector<std::vector<PropertyLookup>> make_property_lookup_table();
 
     bool parse_header(std::istream & is);
-    void parse_data(std::istream & is, bool firstPass);
+    void parse_data(std::istream & is, bool fast_ascii);
+    size_t requested_element_count() const;
+    bool can_parse_fixed_stride() const;
+    void parse_data_fixed_stride(std::istream & is, size_t num_threads, const PlyExecutor & executor);
     void read_header_format(std::istream & is);
     void read_header_element(std::istream & is);
     void read_header_property(std::istream & is);
@@ -293,9 +557,9 @@ struct PlyFile::PlyFileImpl
 
     void write_header(std::ostream & os) noexcept;
     void write_ascii_internal(std::ostream & os) noexcept;
-    void write_binary_internal(std::ostream & os) noexcept;
+    void write_ascii_fast(std::ostream & os, size_t num_threads, const PlyExecutor & executor);
+    void write_binary_internal(std::ostream & os, size_t num_threads, const PlyExecutor & executor);
     void write_property_ascii(Type t, std::ostream & os, const uint8_t * src, size_t & srcOffset);
-    void write_property_binary(std::ostream & os, const uint8_t * src, size_t & srcOffset, const size_t & stride) noexcept;
 };
 
 PlyProperty::PlyProperty(std::istream & is) : isList(false)
@@ -325,16 +589,6 @@ template<typename T> inline T ply_read_ascii(std::istream & is)
     return data;
 }
 
-template<typename T, typename T2>
-inline void endian_swap_buffer(uint8_t * data_ptr, const size_t num_bytes, const size_t stride)
-{
-    for (size_t count = 0; count < num_bytes; count += stride)
-    {
-        *(reinterpret_cast<T2 *>(data_ptr)) = endian_swap<T, T2>(*(reinterpret_cast<const T *>(data_ptr)));
-        data_ptr += stride;
-    }
-}
-
 template<typename T> void ply_cast_ascii(void * dest, std::istream & is)
 {
     *(static_cast<T *>(dest)) = ply_read_ascii<T>(is);
@@ -454,6 +708,50 @@ size_t PlyFile::PlyFileImpl::read_property_ascii(const Type & t, const size_t &
     return stride;
 }
 
+inline void read_property_ascii_fast(const Type & t, void * dest, AsciiCursor & cursor)
+{
+    switch (t)
+    {
+    case Type::INT8:       *((int8_t *)dest)   = static_cast<int8_t>(ply_read_ascii_fast<int32_t>(cursor));   break;
+    case Type::UINT8:      *((uint8_t *)dest)  = static_cast<uint8_t>(ply_read_ascii_fast<uint32_t>(cursor)); break;
+    case Type::INT16:      *((int16_t *)dest)  = ply_read_ascii_fast<int16_t>(cursor);  break;
+    case Type::UINT16:     *((uint16_t *)dest) = ply_read_ascii_fast<uint16_t>(cursor); break;
+    case Type::INT32:      *((int32_t *)dest)  = ply_read_ascii_fast<int32_t>(cursor);  break;
+    case Type::UINT32:     *((uint32_t *)dest) = ply_read_ascii_fast<uint32_t>(cursor); break;
+    case Type::FLOAT32:    *((float *)dest)    = ply_read_ascii_fast<float>(cursor);    break;
+    case Type::FLOAT64:    *((double *)dest)   = ply_read_ascii_fast<double>(cursor);   break;
+    case Type::INVALID:    throw std::invalid_argument("invalid ply property");
+    }
+}
+
+// Longest text of any value (a double in its shortest round trip form is at most 24 characters)
+const size_t ascii_value_chars = 32;
+
+template<typename T> inline char * ply_write_ascii_fast(char * dest, const uint8_t * src) noexcept
+{
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return std::to_chars(dest, dest + ascii_value_chars, value).ptr;
+}
+
+inline char * write_property_ascii_fast(Type t, char * dest, const uint8_t * src)
+{
+    switch (t)
+    {
+    case Type::INT8:       dest = std::to_chars(dest, dest + ascii_value_chars, static_cast<int32_t>(*reinterpret_cast<const int8_t*>(src))).ptr; break;
+    case Type::UINT8:      dest = std::to_chars(dest, dest + ascii_value_chars, static_cast<uint32_t>(*src)).ptr; break;
+    case Type::INT16:      dest = ply_write_ascii_fast<int16_t>(dest, src);  break;
+    case Type::UINT16:     dest = ply_write_ascii_fast<uint16_t>(dest, src); break;
+    case Type::INT32:      dest = ply_write_ascii_fast<int32_t>(dest, src);  break;
+    case Type::UINT32:     dest = ply_write_ascii_fast<uint32_t>(dest, src); break;
+    case Type::FLOAT32:    dest = ply_write_ascii_fast<float>(dest, src);    break;
+    case Type::FLOAT64:    dest = ply_write_ascii_fast<double>(dest, src);   break;
+    case Type::INVALID:    throw std::invalid_argument("invalid ply property");
+    }
+    *dest++ = ' ';
+    return dest;
+}
+
 void PlyFile::PlyFileImpl::write_property_ascii(Type t, std::ostream & os, const uint8_t * src, size_t & srcOffset)
 {
     switch (t)
@@ -472,144 +770,205 @@ void PlyFile::PlyFileImpl::write_property_ascii(Type t, std::ostream & os, const
     srcOffset += PropertyTable[t].stride;
 }
 
-void PlyFile::PlyFileImpl::write_property_binary(std::ostream & os, const uint8_t * src, size_t & srcOffset, const size_t & stride) noexcept
-{
-    os.write((char *)src, stride);
-    srcOffset += stride;
-}
-
-void PlyFile::PlyFileImpl::read(std::istream & is)
+void PlyFile::PlyFileImpl::read(std::istream & is, const PlyReadOptions & options)
 {
-    std::vector<std::shared_ptr<PlyData>> buffers;
-    for (auto & entry : userData) buffers.push_back(entry.second.data);
-
-    // Discover if we can allocate up front without parsing the file twice
-    uint32_t list_hints = 0;
-    for (auto & b : buffers) for (auto & entry : userData) {list_hints += entry.second.list_size_hint;(void)b;}
-
-    // No list hints? Then we need to calculate how much memory to allocate
-    if (list_hints == 0)
+    size_t num_threads = options.num_threads;
+    if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (num_threads > 1 && can_parse_fixed_stride())
     {
-        parse_data(is, true);
+        // allocates each shared buffer once itself
+        parse_data_fixed_stride(is, num_threads, options.executor);
     }
+    else
+    {
+        std::vector<std::shared_ptr<PlyData>> buffers;
+        for (auto & entry : userData) buffers.push_back(entry.second.data);
 
-    // Count the number of properties (required for allocation)
-    // e.g. if we have properties x y and z requested, we ensure
-    // that their buffer points to the same PlyData
-    std::unordered_map<PlyData*, int32_t> unique_data_count;
-    for (auto & ptr : buffers) unique_data_count[ptr.get()] += 1;
+        // Count the number of properties (required for allocation)
+        // e.g. if we have properties x y and z requested, we ensure
+        // that their buffer points to the same PlyData
+        std::unordered_map<PlyData*, int32_t> unique_data_count;
+        for (auto & ptr : buffers) unique_data_count[ptr.get()] += 1;
 
-    // Since group-requested properties share the same cursor,
-    // we need to find unique cursors so we only allocate once
-    std::sort(buffers.begin(), buffers.end());
-    buffers.erase(std::unique(buffers.begin(), buffers.end()), buffers.end());
+        // Since group-requested properties share the same cursor,
+        // we need to find unique cursors so we only allocate once
+        std::sort(buffers.begin(), buffers.end());
+        buffers.erase(std::unique(buffers.begin(), buffers.end()), buffers.end());
 
-    // We sorted by ptrs on PlyData, need to remap back onto its cursor in the userData table
-    for (auto & b : buffers)
-    {
-        for (auto & entry : userData)
+        // We sorted by ptrs on PlyData, need to remap back onto its cursor in the userData table
+        for (auto & b : buffers)
         {
-            if (entry.second.data == b && b->buffer.get() == nullptr)
+            std::shared_ptr<PlyDataArena> arena;
+            for (auto & entry : userData)
             {
-                // If we didn't receive any list hints, it means we did two passes over the
-                // file to compute the total length of all (potentially) variable-length lists
-                if (list_hints == 0)
+                if (entry.second.data != b || b->buffer.get() != nullptr) continue;
+
+                if (b->isList && entry.second.list_size_hint == 0)
                 {
-                    b->buffer = Buffer(entry.second.cursor->totalSizeBytes);
+                    // The total length of the lists is only known once they have been read. They are decoded
+                    // into an arena shared by the group in the same pass, instead of a first pass to size them.
+                    if (!arena) arena = std::make_shared<PlyDataArena>();
+                    entry.second.arena = arena;
                 }
                 else
                 {
-                    // otherwise, we can allocate up front, skipping the first pass.
+                    // otherwise, we can allocate up front
                     const size_t list_size_multiplier = (entry.second.data->isList ? entry.second.list_size_hint : 1);
                     auto bytes_per_property = entry.second.data->count * PropertyTable[entry.second.data->t].stride * list_size_multiplier;
                     bytes_per_property *= unique_data_count[b.get()];
                     b->buffer = Buffer(bytes_per_property);
                 }
-
             }
         }
-    }
 
-    // Populate the data
-    parse_data(is, false);
+        // Populate the data
+        parse_data(is, options.fast_ascii);
 
-    // In-place big-endian to little-endian swapping if required
-    if (isBigEndian)
-    {
         for (auto & b : buffers)
         {
-            uint8_t * data_ptr = b->buffer.get();
-            const size_t stride = PropertyTable[b->t].stride;
-            const size_t buffer_size_bytes = b->buffer.size_bytes();
+            for (auto & entry : userData)
+            {
+                if (entry.second.data == b && entry.second.arena)
+                {
+                    b->buffer = entry.second.arena->compact();
+                    entry.second.cursor->totalSizeBytes = b->buffer.size_bytes();
+                    break;
+                }
+            }
+        }
+        for (auto & entry : userData) entry.second.arena.reset();
 
-            switch (b->t)
+        // In-place big-endian to little-endian swapping if required (the fixed stride
+        // parse swaps each block as it decodes it instead)
+        if (isBigEndian)
+        {
+            for (auto & b : buffers)
             {
-            case Type::INT16:   endian_swap_buffer<int16_t, int16_t>(data_ptr, buffer_size_bytes, stride);   break;
-            case Type::UINT16:  endian_swap_buffer<uint16_t, uint16_t>(data_ptr, buffer_size_bytes, stride); break;
-            case Type::INT32:   endian_swap_buffer<int32_t, int32_t>(data_ptr, buffer_size_bytes, stride);   break;
-            case Type::UINT32:  endian_swap_buffer<uint32_t, uint32_t>(data_ptr, buffer_size_bytes, stride); break;
-            case Type::FLOAT32: endian_swap_buffer<uint32_t, float>(data_ptr, buffer_size_bytes, stride);    break;
-            case Type::FLOAT64: endian_swap_buffer<uint64_t, double>(data_ptr, buffer_size_bytes, stride);   break;
-            default: break;
+                const size_t stride = PropertyTable[b->t].stride;
+                endian_swap_values(b->buffer.get(), b->buffer.size_bytes() / stride, stride);
             }
         }
     }
 }
 
-void PlyFile::PlyFileImpl::write(std::ostream & os, bool _isBinary)
+void PlyFile::PlyFileImpl::write(std::ostream & os, bool _isBinary, const PlyWriteOptions & options)
 {
     for (auto & d : userData) { d.second.cursor->byteOffset = 0; }
     if (_isBinary)
     {
         isBinary = true;
         isBigEndian = false;
-        write_binary_internal(os);
+        size_t num_threads = options.num_threads;
+        if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+        write_binary_internal(os, num_threads, options.executor);
     }
     else
     {
         isBinary = false;
         isBigEndian = false;
-        write_ascii_internal(os);
+        if (options.fast_ascii)
+        {
+            size_t num_threads = options.num_threads;
+            if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+            write_ascii_fast(os, num_threads, options.executor);
+        }
+        else write_ascii_internal(os);
     }
 }
 
-void PlyFile::PlyFileImpl::write_binary_internal(std::ostream & os) noexcept
+void PlyFile::PlyFileImpl::write_binary_internal(std::ostream & os, size_t num_threads, const PlyExecutor & executor)
 {
     isBinary = true;
 
     write_header(os);
 
-    uint8_t listSize[4] = { 0, 0, 0, 0 };
-    size_t dummyCount = 0;
+    // A property of the current element, or adjacent properties of the same buffer merged into one copy:
+    // `size` bytes at `srcOffset` of the `srcStride` byte rows of its buffer go to `destOffset` of every
+    // output row. A list property is preceded by its count, `countSize` bytes of `count`.
+    struct RowCopy
+    {
+        PlyData * data;
+        size_t srcOffset;
+        size_t srcStride;
+        size_t destOffset;
+        size_t size;
+        uint8_t count[4];
+        size_t countSize;
+    };
+
+    // Rows are encoded into blocks of about this size, each written with one call
+    const size_t block_bytes = size_t(8) << 20;
+    const size_t min_rows_per_thread = 4096;
 
     auto element_property_lookup = make_property_lookup_table();
 
-    size_t element_idx = 0;
-    for (auto & e : elements)
+    std::vector<uint8_t> block;
+    for (size_t e = 0; e < elements.size(); ++e)
     {
-        for (size_t i = 0; i < e.size; ++i)
+        const PlyElement & element = elements[e];
+        std::vector<RowCopy> copies;
+        std::unordered_map<PlyData *, size_t> src_row_bytes; // bytes of one row in each source buffer
+        size_t stride = 0;
+        for (size_t p = 0; p < element.properties.size(); ++p)
         {
-            size_t property_index = 0;
-            for (auto & p : e.properties)
+            const PlyProperty & property = element.properties[p];
+            const PropertyLookup & f = element_property_lookup[e][p];
+            if (f.skip || f.helper == nullptr) continue;
+
+            PlyData * data = f.helper->data.get();
+            size_t & src = src_row_bytes[data];
+            const size_t size = property.isList ? f.prop_stride * property.listCount : f.prop_stride;
+            if (property.isList)
             {
-                auto & f = element_property_lookup[element_idx][property_index];
-                auto * helper = f.helper;
-                if (f.skip || helper == nullptr) continue;
+                RowCopy c { data, src, 0, stride + f.list_stride, size, {}, f.list_stride };
+                const uint32_t count = static_cast<uint32_t>(property.listCount);
+                std::memcpy(c.count, &count, sizeof(count));
+                copies.push_back(c);
+                stride += f.list_stride;
+            }
+            else if (!copies.empty() && copies.back().data == data && copies.back().countSize == 0 &&
+                copies.back().srcOffset + copies.back().size == src && copies.back().destOffset + copies.back().size == stride)
+            {
+                copies.back().size += size;
+            }
+            else copies.push_back({ data, src, 0, stride, size, {}, 0 });
+            src += size;
+            stride += size;
+        }
 
-                if (p.isList)
-                {
-                    std::memcpy(listSize, &p.listCount, sizeof(uint32_t));
-                    write_property_binary(os, listSize, dummyCount, f.list_stride);
-                    write_property_binary(os, (helper->data->buffer.get_const() + helper->cursor->byteOffset), helper->cursor->byteOffset, f.prop_stride * p.listCount);
-                }
-                else
+        for (auto & c : copies) c.srcStride = src_row_bytes[c.data];
+        for (auto & entry : userData)
+        {
+            auto it = src_row_bytes.find(entry.second.data.get());
+            if (it != src_row_bytes.end()) entry.second.cursor->byteOffset = it->second * element.size;
+        }
+        if (stride == 0) continue;
+
+        const size_t rows_per_block = std::max<size_t>(1, block_bytes / stride);
+        for (size_t first = 0; first < element.size; first += rows_per_block)
+        {
+            const size_t rows = std::min(rows_per_block, element.size - first);
+            block.resize(rows * stride);
+
+            auto encode = [&](size_t begin, size_t end) noexcept
+            {
+                for (const auto & c : copies)
                 {
-                    write_property_binary(os, (helper->data->buffer.get_const() + helper->cursor->byteOffset), helper->cursor->byteOffset, f.prop_stride);
+                    const uint8_t * src = c.data->buffer.get_const() + (first + begin) * c.srcStride + c.srcOffset;
+                    uint8_t * dest = block.data() + begin * stride + c.destOffset;
+                    for (size_t row = begin; row < end; ++row, src += c.srcStride, dest += stride)
+                    {
+                        if (c.countSize) std::memcpy(dest - c.countSize, c.count, c.countSize);
+                        std::memcpy(dest, src, c.size);
+                    }
                 }
-                property_index++;
-            }
+            };
+
+            const size_t threads = std::max<size_t>(1, std::min(num_threads, rows / min_rows_per_thread));
+            run_concurrently(executor, threads, [&](size_t t) { encode(rows * t / threads, rows * (t + 1) / threads); });
+
+            os.write(reinterpret_cast<const char *>(block.data()), static_cast<std::streamsize>(block.size()));
         }
-        element_idx++;
     }
 }
 
@@ -651,6 +1010,92 @@ void PlyFile::PlyFileImpl::write_ascii_internal(std::ostream & os) noexcept
     }
 }
 
+void PlyFile::PlyFileImpl::write_ascii_fast(std::ostream & os, size_t num_threads, const PlyExecutor & executor)
+{
+    write_header(os);
+
+    // A property of the current element: values at `srcOffset` of the `srcStride` byte rows of its buffer
+    struct RowFormat
+    {
+        PlyData * data;
+        size_t srcOffset;
+        size_t srcStride;
+        Type t;
+        size_t stride;
+        bool isList;
+        size_t listCount;
+    };
+
+    // Rows are formatted in blocks of this many, split into one range per thread. The ranges are written in order.
+    const size_t block_rows = size_t(1) << 18;
+    const size_t min_rows_per_thread = 4096;
+
+    auto element_property_lookup = make_property_lookup_table();
+
+    std::vector<std::vector<char>> text(num_threads);
+    std::vector<size_t> text_size(num_threads);
+    for (size_t e = 0; e < elements.size(); ++e)
+    {
+        const PlyElement & element = elements[e];
+        std::vector<RowFormat> formats;
+        std::unordered_map<PlyData *, size_t> src_row_bytes;
+        size_t row_chars = 1; // the newline
+        for (size_t p = 0; p < element.properties.size(); ++p)
+        {
+            const PlyProperty & property = element.properties[p];
+            const PropertyLookup & f = element_property_lookup[e][p];
+            if (f.skip || f.helper == nullptr) continue;
+
+            PlyData * data = f.helper->data.get();
+            size_t & src = src_row_bytes[data];
+            const size_t values = property.isList ? property.listCount : 1;
+            formats.push_back({ data, src, 0, property.propertyType, f.prop_stride, property.isList, property.listCount });
+            src += f.prop_stride * values;
+            row_chars += (values + (property.isList ? 1 : 0)) * (ascii_value_chars + 1);
+        }
+        for (auto & f : formats) f.srcStride = src_row_bytes[f.data];
+        for (auto & entry : userData)
+        {
+            auto it = src_row_bytes.find(entry.second.data.get());
+            if (it != src_row_bytes.end()) entry.second.cursor->byteOffset = it->second * element.size;
+        }
+
+        for (size_t first = 0; first < element.size; first += block_rows)
+        {
+            const size_t rows = std::min(block_rows, element.size - first);
+
+            auto format = [&](size_t t, size_t begin, size_t end)
+            {
+                std::vector<char> & out = text[t];
+                if (out.size() < (end - begin) * row_chars) out.resize((end - begin) * row_chars);
+                char * dest = out.data();
+                for (size_t row = first + begin; row < first + end; ++row)
+                {
+                    for (const auto & f : formats)
+                    {
+                        const uint8_t * src = f.data->buffer.get_const() + row * f.srcStride + f.srcOffset;
+                        if (!f.isList)
+                        {
+                            dest = write_property_ascii_fast(f.t, dest, src);
+                            continue;
+                        }
+                        dest = std::to_chars(dest, dest + ascii_value_chars, f.listCount).ptr;
+                        *dest++ = ' ';
+                        for (size_t j = 0; j < f.listCount; ++j, src += f.stride) dest = write_property_ascii_fast(f.t, dest, src);
+                    }
+                    *dest++ = '\n';
+                }
+                text_size[t] = static_cast<size_t>(dest - out.data());
+            };
+
+            const size_t threads = std::max<size_t>(1, std::min(num_threads, rows / min_rows_per_thread));
+            run_concurrently(executor, threads, [&](size_t t) { format(t, rows * t / threads, rows * (t + 1) / threads); });
+
+            for (size_t t = 0; t < threads; ++t) os.write(text[t].data(), static_cast<std::streamsize>(text_size[t]));
+        }
+    }
+}
+
 void PlyFile::PlyFileImpl::write_header(std::ostream & os) noexcept
 {
     const std::locale & fixLoc = std::locale("C");
@@ -808,16 +1253,149 @@ void PlyFile::PlyFileImpl::add_properties_to_element(const std::string & element
     }
 }
 
-void PlyFile::PlyFileImpl::parse_data(std::istream & is, bool firstPass)
+// One past the last element with requested properties, the elements after it do not need to be parsed
+size_t PlyFile::PlyFileImpl::requested_element_count() const
+{
+    size_t count = 0;
+    for (size_t e = 0; e < elements.size(); ++e)
+    {
+        for (auto & property : elements[e].properties)
+        {
+            if (userData.count(hash_fnv1a(elements[e].name + property.name))) count = e + 1;
+        }
+    }
+    return count;
+}
+
+// True if binary and every element up to the last requested one has a fixed row size
+bool PlyFile::PlyFileImpl::can_parse_fixed_stride() const
+{
+    if (!isBinary) return false;
+    const size_t count = requested_element_count();
+    for (size_t e = 0; e < count; ++e)
+    {
+        for (auto & property : elements[e].properties) if (property.isList) return false;
+    }
+    return true;
+}
+
+void PlyFile::PlyFileImpl::parse_data_fixed_stride(std::istream & is, size_t num_threads, const PlyExecutor & executor)
+{
+    // A requested property of the current element: `size` bytes at `srcOffset` of every row go to
+    // `destOffset` of the `destStride` byte rows of its buffer. Adjacent properties of the same buffer
+    // (e.g. x, y, z) are merged into one copy.
+    struct RowCopy
+    {
+        PlyData * data;
+        size_t srcOffset;
+        size_t destOffset;
+        size_t size;
+        size_t destStride;
+    };
+
+    // Rows are read in blocks of about this size, then decoded by all threads
+    const size_t block_bytes = size_t(64) << 20;
+    const size_t min_rows_per_thread = 4096;
+    // Rows decoded before swapping them, small enough that the decoded rows stay in L1
+    const size_t swap_rows = 512;
+
+    std::vector<uint8_t> block;
+    const size_t element_count = requested_element_count();
+    for (size_t e = 0; e < element_count; ++e)
+    {
+        const PlyElement & element = elements[e];
+        std::vector<RowCopy> copies;
+        std::unordered_map<PlyData *, size_t> row_bytes; // bytes of one row in each requested buffer
+        size_t stride = 0;
+        for (auto & property : element.properties)
+        {
+            const size_t prop_stride = PropertyTable[property.propertyType].stride;
+            auto it = userData.find(hash_fnv1a(element.name + property.name));
+            if (it != userData.end())
+            {
+                PlyData * data = it->second.data.get();
+                size_t & dest = row_bytes[data];
+                if (!copies.empty() && copies.back().data == data &&
+                    copies.back().srcOffset + copies.back().size == stride && copies.back().destOffset + copies.back().size == dest)
+                {
+                    copies.back().size += prop_stride;
+                }
+                else copies.push_back({ data, stride, dest, prop_stride, 0 });
+                dest += prop_stride;
+            }
+            stride += prop_stride;
+        }
+
+        if (copies.empty())
+        {
+            is.ignore(static_cast<std::streamsize>(stride * element.size));
+            continue;
+        }
+
+        for (auto & c : copies) c.destStride = row_bytes[c.data];
+        for (auto & entry : row_bytes)
+        {
+            if (entry.first->buffer.get() == nullptr) entry.first->buffer = Buffer(entry.second * element.size);
+        }
+
+        // Big-endian rows are swapped right after they are copied, while they are still in cache
+        struct RowSwap
+        {
+            PlyData * data;
+            size_t rowBytes;
+            size_t width;
+        };
+        std::vector<RowSwap> swaps;
+        if (isBigEndian)
+        {
+            for (auto & entry : row_bytes)
+            {
+                const size_t width = PropertyTable[entry.first->t].stride;
+                if (width > 1) swaps.push_back({ entry.first, entry.second, width });
+            }
+        }
+
+        const size_t rows_per_block = std::max<size_t>(1, block_bytes / std::max<size_t>(1, stride));
+        for (size_t first = 0; first < element.size; first += rows_per_block)
+        {
+            const size_t rows = std::min(rows_per_block, element.size - first);
+            block.resize(rows * stride);
+            is.read(reinterpret_cast<char *>(block.data()), static_cast<std::streamsize>(block.size()));
+            if (static_cast<size_t>(is.gcount()) != block.size()) throw std::runtime_error("unexpected end of file in element " + element.name);
+
+            auto decode = [&](size_t begin, size_t end) noexcept
+            {
+                for (size_t part = begin; part < end; part += swap_rows)
+                {
+                    const size_t part_end = std::min(end, part + swap_rows);
+                    for (const auto & c : copies)
+                    {
+                        const uint8_t * src = block.data() + part * stride + c.srcOffset;
+                        uint8_t * dest = c.data->buffer.get() + (first + part) * c.destStride + c.destOffset;
+                        for (size_t row = part; row < part_end; ++row, src += stride, dest += c.destStride) std::memcpy(dest, src, c.size);
+                    }
+                    for (const auto & s : swaps)
+                        endian_swap_values(s.data->buffer.get() + (first + part) * s.rowBytes, (part_end - part) * s.rowBytes / s.width, s.width);
+                }
+            };
+
+            const size_t threads = std::max<size_t>(1, std::min(num_threads, rows / min_rows_per_thread));
+            run_concurrently(executor, threads, [&](size_t t) { decode(rows * t / threads, rows * (t + 1) / threads); });
+        }
+    }
+}
+
+void PlyFile::PlyFileImpl::parse_data(std::istream & is, bool fast_ascii)
 {
     std::function<void(PropertyLookup & f, const PlyProperty & p, uint8_t * dest, size_t & destOffset, std::istream & is)> read;
+    std::function<void(PropertyLookup & f, const PlyProperty & p, PlyDataArena & arena, std::istream & is)> read_list;
     std::function<size_t(PropertyLookup & f, const PlyProperty & p, std::istream & is)> skip;
 
-    const auto start = is.tellg();
-
     uint32_t listSize = 0;
     size_t dummyCount = 0;
     std::string skip_ascii_buffer;
+    std::vector<char> ascii_text;
+    AsciiCursor cursor {};
 
     // Special case mirroring read_property_binary but for list types; this
     // has an additional big endian check to flip the data in place immediately
@@ -855,6 +1433,12 @@ void PlyFile::PlyFileImpl::parse_data(std::istream & is, bool firstPass)
             read_list_binary(p.listType, &listSize, dummyCount, f.list_stride, _is); // the list size
             return read_property_binary(f.prop_stride * listSize, dest + destOffset, destOffset, _is); // properties in list
         };
+        read_list = [this, &listSize, &dummyCount, &read_list_binary](PropertyLookup & f, const PlyProperty & p, PlyDataArena & arena, std::istream & _is)
+        {
+            read_list_binary(p.listType, &listSize, dummyCount, f.list_stride, _is); // the list size
+            size_t offset = 0;
+            read_property_binary(f.prop_stride * listSize, arena.allocate(f.prop_stride * listSize), offset, _is); // properties in list
+        };
         skip = [this, &listSize, &dummyCount, &read_list_binary](PropertyLookup & f, const PlyProperty & p, std::istream & _is) noexcept
         {
             if (!p.isList)
@@ -868,6 +1452,63 @@ void PlyFile::PlyFileImpl::parse_data(std::istream & is, bool firstPass)
             return bytes_to_skip;
         };
     }
+    else if (fast_ascii)
+    {
+        // The rest of the stream in one read when its size is known
+        const auto start = is.tellg();
+        is.seekg(0, is.end);
+        const auto end = is.tellg();
+        if (start != std::istream::pos_type(-1) && end != std::istream::pos_type(-1))
+        {
+            is.seekg(start);
+            ascii_text.resize(static_cast<size_t>(end - start));
+            is.read(ascii_text.data(), static_cast<std::streamsize>(ascii_text.size()));
+            ascii_text.resize(static_cast<size_t>(is.gcount()));
+        }
+        else
+        {
+            is.clear();
+            ascii_text.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+        }
+        cursor = { ascii_text.data(), ascii_text.data() + ascii_text.size() };
+
+        read = [&cursor, &listSize](PropertyLookup & f, const PlyProperty & p, uint8_t * dest, size_t & destOffset, std::istream &)
+        {
+            if (!p.isList)
+            {
+                read_property_ascii_fast(p.propertyType, dest + destOffset, cursor);
+                destOffset += f.prop_stride;
+            }
+            else
+            {
+                listSize = ply_read_ascii_fast<uint32_t>(cursor); // the list size
+                for (size_t i = 0; i < listSize; ++i, destOffset += f.prop_stride)
+                {
+                    read_property_ascii_fast(p.propertyType, dest + destOffset, cursor);
+                }
+            }
+        };
+        read_list = [&cursor, &listSize](PropertyLookup & f, const PlyProperty & p, PlyDataArena & arena, std::istream &)
+        {
+            listSize = ply_read_ascii_fast<uint32_t>(cursor); // the list size
+            uint8_t * dest = arena.allocate(f.prop_stride * listSize);
+            for (size_t i = 0; i < listSize; ++i)
+            {
+                read_property_ascii_fast(p.propertyType, dest + i * f.prop_stride, cursor);
+            }
+        };
+        skip = [&cursor, &listSize](PropertyLookup & f, const PlyProperty & p, std::istream &)
+        {
+            if (p.isList)
+            {
+                listSize = ply_read_ascii_fast<uint32_t>(cursor); // the list size (does not count for memory alloc)
+                for (size_t i = 0; i < listSize; ++i) cursor.token(); // properties in list
+                return listSize * f.prop_stride;
+            }
+            cursor.token();
+            return f.prop_stride;
+        };
+    }
     else
     {
         read = [this, &listSize, &dummyCount](PropertyLookup & f, const PlyProperty & p, uint8_t * dest, size_t & destOffset, std::istream & _is) noexcept
@@ -885,6 +1526,16 @@ void PlyFile::PlyFileImpl::parse_data(std::istream & is, bool firstPass)
                 }
             }
         };
+        read_list = [this, &listSize, &dummyCount](PropertyLookup & f, const PlyProperty & p, PlyDataArena & arena, std::istream & _is)
+        {
+            read_property_ascii(p.listType, f.list_stride, &listSize, dummyCount, _is); // the list size
+            uint8_t * dest = arena.allocate(f.prop_stride * listSize);
+            size_t offset = 0;
+            for (size_t i = 0; i < listSize; ++i)
+            {
+                read_property_ascii(p.propertyType, f.prop_stride, dest + offset, offset, _is);
+            }
+        };
         skip = [this, &listSize, &dummyCount, &skip_ascii_buffer](PropertyLookup & f, const PlyProperty & p, std::istream & _is) noexcept
         {
             skip_ascii_buffer.clear();
@@ -917,9 +1568,9 @@ void PlyFile::PlyFileImpl::parse_data(std::istream & is, bool firstPass)
                 if (!lookup.skip)
                 {
                     helper = lookup.helper;
-                    if (firstPass)
+                    if (helper->arena && property.isList)
                     {
-                        helper->cursor->totalSizeBytes += skip(lookup, property, is);
+                        read_list(lookup, property, *helper->arena, is);
 
                         // These lines will be changed when tinyply supports
                         // variable length lists. We add it here so our header data structure
@@ -941,9 +1592,6 @@ void PlyFile::PlyFileImpl::parse_data(std::istream & is, bool firstPass)
         }
         element_idx++;
     }
-
-    // Reset istream position to the start of the data
-    if (firstPass) is.seekg(start, is.beg);
 }
 
 // Wrap the public interface:
@@ -951,12 +1599,15 @@ void PlyFile::PlyFileImpl::parse_data(std::istream & is, bool firstPass)
 PlyFile::PlyFile() { impl.reset(new PlyFileImpl()); }
 PlyFile::~PlyFile() { }
 bool PlyFile::parse_header(std::istream & is) { return impl->parse_header(is); }
-void PlyFile::read(std::istream & is) { return impl->read(is); }
-void PlyFile::write(std::ostream & os, bool isBinary) { return impl->write(os, isBinary); }
+void PlyFile::read(std::istream & is) { return impl->read(is, PlyReadOptions()); }
+void PlyFile::read(std::istream & is, const PlyReadOptions & options) { return impl->read(is, options); }
+void PlyFile::write(std::ostream & os, bool isBinary) { return impl->write(os, isBinary, PlyWriteOptions()); }
+void PlyFile::write(std::ostream & os, bool isBinary, const PlyWriteOptions & options) { return impl->write(os, isBinary, options); }
 std::vector<PlyElement> PlyFile::get_elements() const { return impl->elements; }
 std::vector<std::string> & PlyFile::get_comments() { return impl->comments; }
 std::vector<std::string> PlyFile::get_info() const { return impl->objInfo; }
 bool PlyFile::is_binary_file() const { return impl->isBinary; }
+bool PlyFile::is_big_endian_file() const { return impl->isBigEndian; }
 std::shared_ptr<PlyData> PlyFile::request_properties_from_element(const std::string & elementKey,
     const std::vector<std::string> propertyKeys,
     const uint32_t list_size_hint)
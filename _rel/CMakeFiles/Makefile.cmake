@@ -0,0 +1,77 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "/root/repo/JL/CMakeLists.txt"
+  "/root/repo/JL/benchmarks/CMakeLists.txt"
+  "/root/repo/JL/geometry/CMakeLists.txt"
+  "/root/repo/JL/geometryTest/CMakeLists.txt"
+  "/root/repo/JL/matrix/CMakeLists.txt"
+  "/root/repo/JL/matrixTest/CMakeLists.txt"
+  "/root/repo/JL/utils/CMakeLists.txt"
+  "/root/repo/Libs/CMakeLists.txt"
+  "/root/repo/Libs/tinyply/CMakeLists.txt"
+  "/root/repo/Libs/tinyplyTest/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "Libs/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "Libs/tinyply/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "Libs/tinyplyTest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "JL/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "JL/utils/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "JL/geometry/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "JL/geometryTest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "JL/matrix/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "JL/matrixTest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "JL/benchmarks/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "Libs/tinyply/CMakeFiles/tinyply.dir/DependInfo.cmake"
+  "Libs/tinyplyTest/CMakeFiles/tinyplyTest.dir/DependInfo.cmake"
+  "JL/utils/CMakeFiles/utils.dir/DependInfo.cmake"
+  "JL/geometry/CMakeFiles/geometry.dir/DependInfo.cmake"
+  "JL/geometryTest/CMakeFiles/geometryTest.dir/DependInfo.cmake"
+  "JL/matrix/CMakeFiles/matrix.dir/DependInfo.cmake"
+  "JL/matrixTest/CMakeFiles/matrixTest.dir/DependInfo.cmake"
+  "JL/benchmarks/CMakeFiles/jlBenchmarks.dir/DependInfo.cmake"
+  )
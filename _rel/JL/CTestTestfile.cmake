@@ -0,0 +1,12 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/JL
+# Build directory: /root/repo/_rel/JL
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("utils")
+subdirs("geometry")
+subdirs("geometryTest")
+subdirs("matrix")
+subdirs("matrixTest")
+subdirs("benchmarks")
@@ -0,0 +1,26 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/JL/benchmarks/MatrixBenchmark.cpp" "JL/benchmarks/CMakeFiles/jlBenchmarks.dir/MatrixBenchmark.cpp.o" "gcc" "JL/benchmarks/CMakeFiles/jlBenchmarks.dir/MatrixBenchmark.cpp.o.d"
+  "/root/repo/JL/benchmarks/PlyBenchmark.cpp" "JL/benchmarks/CMakeFiles/jlBenchmarks.dir/PlyBenchmark.cpp.o" "gcc" "JL/benchmarks/CMakeFiles/jlBenchmarks.dir/PlyBenchmark.cpp.o.d"
+  "/root/repo/JL/benchmarks/PointBenchmark.cpp" "JL/benchmarks/CMakeFiles/jlBenchmarks.dir/PointBenchmark.cpp.o" "gcc" "JL/benchmarks/CMakeFiles/jlBenchmarks.dir/PointBenchmark.cpp.o.d"
+  "/root/repo/JL/benchmarks/main.cpp" "JL/benchmarks/CMakeFiles/jlBenchmarks.dir/main.cpp.o" "gcc" "JL/benchmarks/CMakeFiles/jlBenchmarks.dir/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel/JL/matrix/CMakeFiles/matrix.dir/DependInfo.cmake"
+  "/root/repo/_rel/JL/geometry/CMakeFiles/geometry.dir/DependInfo.cmake"
+  "/root/repo/_rel/JL/utils/CMakeFiles/utils.dir/DependInfo.cmake"
+  "/root/repo/_rel/Libs/tinyply/CMakeFiles/tinyply.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/jlBenchmarks.dir/MatrixBenchmark.cpp.o"
+  "CMakeFiles/jlBenchmarks.dir/MatrixBenchmark.cpp.o.d"
+  "CMakeFiles/jlBenchmarks.dir/PlyBenchmark.cpp.o"
+  "CMakeFiles/jlBenchmarks.dir/PlyBenchmark.cpp.o.d"
+  "CMakeFiles/jlBenchmarks.dir/PointBenchmark.cpp.o"
+  "CMakeFiles/jlBenchmarks.dir/PointBenchmark.cpp.o.d"
+  "CMakeFiles/jlBenchmarks.dir/main.cpp.o"
+  "CMakeFiles/jlBenchmarks.dir/main.cpp.o.d"
+  "jlBenchmarks"
+  "jlBenchmarks.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/jlBenchmarks.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
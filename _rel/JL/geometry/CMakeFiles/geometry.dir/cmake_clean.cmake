@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/geometry.dir/src/temp.cpp.o"
+  "CMakeFiles/geometry.dir/src/temp.cpp.o.d"
+  "libgeometry.a"
+  "libgeometry.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/geometry.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
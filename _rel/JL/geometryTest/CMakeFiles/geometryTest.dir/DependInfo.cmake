@@ -0,0 +1,26 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/JL/geometryTest/InfiniteRegularGridTest.cpp" "JL/geometryTest/CMakeFiles/geometryTest.dir/InfiniteRegularGridTest.cpp.o" "gcc" "JL/geometryTest/CMakeFiles/geometryTest.dir/InfiniteRegularGridTest.cpp.o.d"
+  "/root/repo/JL/geometryTest/PlyTest.cpp" "JL/geometryTest/CMakeFiles/geometryTest.dir/PlyTest.cpp.o" "gcc" "JL/geometryTest/CMakeFiles/geometryTest.dir/PlyTest.cpp.o.d"
+  "/root/repo/JL/geometryTest/PointCloudTest.cpp" "JL/geometryTest/CMakeFiles/geometryTest.dir/PointCloudTest.cpp.o" "gcc" "JL/geometryTest/CMakeFiles/geometryTest.dir/PointCloudTest.cpp.o.d"
+  "/root/repo/JL/geometryTest/PointTest.cpp" "JL/geometryTest/CMakeFiles/geometryTest.dir/PointTest.cpp.o" "gcc" "JL/geometryTest/CMakeFiles/geometryTest.dir/PointTest.cpp.o.d"
+  "/root/repo/JL/geometryTest/main.cpp" "JL/geometryTest/CMakeFiles/geometryTest.dir/main.cpp.o" "gcc" "JL/geometryTest/CMakeFiles/geometryTest.dir/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel/JL/geometry/CMakeFiles/geometry.dir/DependInfo.cmake"
+  "/root/repo/_rel/JL/utils/CMakeFiles/utils.dir/DependInfo.cmake"
+  "/root/repo/_rel/Libs/tinyply/CMakeFiles/tinyply.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/geometryTest.dir/InfiniteRegularGridTest.cpp.o"
+  "CMakeFiles/geometryTest.dir/InfiniteRegularGridTest.cpp.o.d"
+  "CMakeFiles/geometryTest.dir/PlyTest.cpp.o"
+  "CMakeFiles/geometryTest.dir/PlyTest.cpp.o.d"
+  "CMakeFiles/geometryTest.dir/PointCloudTest.cpp.o"
+  "CMakeFiles/geometryTest.dir/PointCloudTest.cpp.o.d"
+  "CMakeFiles/geometryTest.dir/PointTest.cpp.o"
+  "CMakeFiles/geometryTest.dir/PointTest.cpp.o.d"
+  "CMakeFiles/geometryTest.dir/main.cpp.o"
+  "CMakeFiles/geometryTest.dir/main.cpp.o.d"
+  "geometryTest"
+  "geometryTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/geometryTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/JL/geometryTest
+# Build directory: /root/repo/_rel/JL/geometryTest
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(geometryTest "/root/repo/_rel/JL/geometryTest/geometryTest")
+set_tests_properties(geometryTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/JL/geometryTest/CMakeLists.txt;15;add_test;/root/repo/JL/geometryTest/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/matrix.dir/src/temp.cpp.o"
+  "CMakeFiles/matrix.dir/src/temp.cpp.o.d"
+  "libmatrix.a"
+  "libmatrix.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/matrix.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,28 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/JL/matrixTest/DynamicMatrixTest.cpp" "JL/matrixTest/CMakeFiles/matrixTest.dir/DynamicMatrixTest.cpp.o" "gcc" "JL/matrixTest/CMakeFiles/matrixTest.dir/DynamicMatrixTest.cpp.o.d"
+  "/root/repo/JL/matrixTest/LUDecompositionTest.cpp" "JL/matrixTest/CMakeFiles/matrixTest.dir/LUDecompositionTest.cpp.o" "gcc" "JL/matrixTest/CMakeFiles/matrixTest.dir/LUDecompositionTest.cpp.o.d"
+  "/root/repo/JL/matrixTest/LinearTransformationTest.cpp" "JL/matrixTest/CMakeFiles/matrixTest.dir/LinearTransformationTest.cpp.o" "gcc" "JL/matrixTest/CMakeFiles/matrixTest.dir/LinearTransformationTest.cpp.o.d"
+  "/root/repo/JL/matrixTest/MatrixPackTest.cpp" "JL/matrixTest/CMakeFiles/matrixTest.dir/MatrixPackTest.cpp.o" "gcc" "JL/matrixTest/CMakeFiles/matrixTest.dir/MatrixPackTest.cpp.o.d"
+  "/root/repo/JL/matrixTest/MatrixTest.cpp" "JL/matrixTest/CMakeFiles/matrixTest.dir/MatrixTest.cpp.o" "gcc" "JL/matrixTest/CMakeFiles/matrixTest.dir/MatrixTest.cpp.o.d"
+  "/root/repo/JL/matrixTest/main.cpp" "JL/matrixTest/CMakeFiles/matrixTest.dir/main.cpp.o" "gcc" "JL/matrixTest/CMakeFiles/matrixTest.dir/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel/JL/matrix/CMakeFiles/matrix.dir/DependInfo.cmake"
+  "/root/repo/_rel/JL/geometry/CMakeFiles/geometry.dir/DependInfo.cmake"
+  "/root/repo/_rel/JL/utils/CMakeFiles/utils.dir/DependInfo.cmake"
+  "/root/repo/_rel/Libs/tinyply/CMakeFiles/tinyply.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
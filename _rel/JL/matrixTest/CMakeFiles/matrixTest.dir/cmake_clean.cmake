@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/matrixTest.dir/DynamicMatrixTest.cpp.o"
+  "CMakeFiles/matrixTest.dir/DynamicMatrixTest.cpp.o.d"
+  "CMakeFiles/matrixTest.dir/LUDecompositionTest.cpp.o"
+  "CMakeFiles/matrixTest.dir/LUDecompositionTest.cpp.o.d"
+  "CMakeFiles/matrixTest.dir/LinearTransformationTest.cpp.o"
+  "CMakeFiles/matrixTest.dir/LinearTransformationTest.cpp.o.d"
+  "CMakeFiles/matrixTest.dir/MatrixPackTest.cpp.o"
+  "CMakeFiles/matrixTest.dir/MatrixPackTest.cpp.o.d"
+  "CMakeFiles/matrixTest.dir/MatrixTest.cpp.o"
+  "CMakeFiles/matrixTest.dir/MatrixTest.cpp.o.d"
+  "CMakeFiles/matrixTest.dir/main.cpp.o"
+  "CMakeFiles/matrixTest.dir/main.cpp.o.d"
+  "matrixTest"
+  "matrixTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/matrixTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/JL/matrixTest
+# Build directory: /root/repo/_rel/JL/matrixTest
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(matrixTest "/root/repo/_rel/JL/matrixTest/matrixTest")
+set_tests_properties(matrixTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/JL/matrixTest/CMakeLists.txt;15;add_test;/root/repo/JL/matrixTest/CMakeLists.txt;0;")
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/JL/utils/src/MappedFile.cpp" "JL/utils/CMakeFiles/utils.dir/src/MappedFile.cpp.o" "gcc" "JL/utils/CMakeFiles/utils.dir/src/MappedFile.cpp.o.d"
+  "/root/repo/JL/utils/src/Simd.cpp" "JL/utils/CMakeFiles/utils.dir/src/Simd.cpp.o" "gcc" "JL/utils/CMakeFiles/utils.dir/src/Simd.cpp.o.d"
+  "/root/repo/JL/utils/src/ThreadPool.cpp" "JL/utils/CMakeFiles/utils.dir/src/ThreadPool.cpp.o" "gcc" "JL/utils/CMakeFiles/utils.dir/src/ThreadPool.cpp.o.d"
+  "/root/repo/JL/utils/src/Utils.cpp" "JL/utils/CMakeFiles/utils.dir/src/Utils.cpp.o" "gcc" "JL/utils/CMakeFiles/utils.dir/src/Utils.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
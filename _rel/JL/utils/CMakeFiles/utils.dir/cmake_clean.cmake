@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/utils.dir/src/MappedFile.cpp.o"
+  "CMakeFiles/utils.dir/src/MappedFile.cpp.o.d"
+  "CMakeFiles/utils.dir/src/Simd.cpp.o"
+  "CMakeFiles/utils.dir/src/Simd.cpp.o.d"
+  "CMakeFiles/utils.dir/src/ThreadPool.cpp.o"
+  "CMakeFiles/utils.dir/src/ThreadPool.cpp.o.d"
+  "CMakeFiles/utils.dir/src/Utils.cpp.o"
+  "CMakeFiles/utils.dir/src/Utils.cpp.o.d"
+  "libutils.a"
+  "libutils.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/utils.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tinyply.dir/src/tinyply.cpp.o"
+  "CMakeFiles/tinyply.dir/src/tinyply.cpp.o.d"
+  "libtinyply.a"
+  "libtinyply.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tinyply.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
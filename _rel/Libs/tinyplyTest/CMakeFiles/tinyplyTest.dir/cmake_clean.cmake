@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tinyplyTest.dir/tests.cpp.o"
+  "CMakeFiles/tinyplyTest.dir/tests.cpp.o.d"
+  "tinyplyTest"
+  "tinyplyTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tinyplyTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/Libs/tinyplyTest
+# Build directory: /root/repo/_rel/Libs/tinyplyTest
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(tinyplyTest "/root/repo/_rel/Libs/tinyplyTest/tinyplyTest")
+set_tests_properties(tinyplyTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/Libs/tinyplyTest/CMakeLists.txt;9;add_test;/root/repo/Libs/tinyplyTest/CMakeLists.txt;0;")